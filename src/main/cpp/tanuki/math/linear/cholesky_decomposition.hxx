@@ -8,8 +8,8 @@
 #include <utility>
 #include <vector>
 
-#include "tanuki/common/divider/group_delimiter.h"
 #include "tanuki/parallel/mpi/mpi_basic_datatype.h"
+#include "tanuki/parallel/mpi/mpi_persistent_allgatherv.h"
 
 namespace tanuki {
 namespace math {
@@ -24,6 +24,7 @@ using arma::Col;
 using arma::Mat;
 
 using tanuki::parallel::mpi::MpiBasicDatatype;
+using tanuki::parallel::mpi::MpiPersistentAllgatherv;
 
 template <typename T>
 CholeskyDecomposition<T>::CholeskyDecomposition(
@@ -56,59 +57,96 @@ const Mat<T> &CholeskyDecomposition<T>::l() {
     lower(0, 0) = first_element;
   }
 
-  for (size_t j = 1; j != lower.n_cols; ++j) {
-    const auto part_j_row = lower.submat(j, 0, j, j - 1);
+  // Number of rows owned by each MPI process, where row i is owned by the
+  // MPI process of rank i modulo the number of MPI processes.
+  vector<int> owned_counts(mpi_comm_size);
 
-    lower(j, j) = std::sqrt(
-        a(j, j) - as_scalar(part_j_row * part_j_row.t()));
+  // Displacement of the owned rows of each MPI process in the column buffer.
+  vector<int> owned_displs(mpi_comm_size);
+
+  for (int rank = 0; rank != mpi_comm_size; ++rank) {
+    owned_counts[rank] = static_cast<size_t>(rank) < lower.n_rows ?
+        (lower.n_rows - rank + mpi_comm_size - 1) / mpi_comm_size : 0;
 
-    // Indices of row groups across MPI processes.
-    const auto row_groups = common::divider::GroupIndices(
-        j + 1, lower.n_rows, mpi_comm_size);
+    owned_displs[rank] =
+        rank == 0 ? 0 : owned_displs[rank - 1] + owned_counts[rank - 1];
+  }
+
+  // Buffer of a column, where the owned rows of each MPI process are
+  // contiguous.
+  vector<T> col_buf(lower.n_rows);
+
+  // Columns are in panels whose width is the number of MPI processes, so that
+  // the rows at or below the first diagonal of a panel are the owned rows of
+  // each MPI process from the same index, which is the index of the panel.
+  // Only these rows are gathered for the columns of a panel, and the
+  // gathering is set up once per panel.
+  unique_ptr<MpiPersistentAllgatherv> col_gather;
 
-    {
-      const size_t row_first = row_groups[mpi_rank];
-      const size_t row_last = row_groups[mpi_rank + 1];
+  // Index of the panel of the current gathering, which is also the index of
+  // the first gathered owned row of each MPI process.
+  size_t gather_panel = 0;
+
+  for (size_t j = 1; j != lower.n_cols; ++j) {
+    const size_t panel = j / mpi_comm_size;
 
-      if (row_last != row_first) {
-        // View of part of the column below the diagonal for this MPI process.
-        auto below = lower.submat(row_first, j, row_last - 1, j);
+    if (col_gather == nullptr || panel != gather_panel) {
+      vector<int> gather_counts(mpi_comm_size);
+      vector<int> gather_displs(mpi_comm_size);
 
-        below -= lower.submat(row_first, 0, row_last - 1, j - 1) *
-            part_j_row.t();
+      for (int rank = 0; rank != mpi_comm_size; ++rank) {
+        const int first = std::min<int>(panel, owned_counts[rank]);
 
-        below /= lower(j, j);
+        gather_counts[rank] = owned_counts[rank] - first;
+        gather_displs[rank] = owned_displs[rank] + first;
       }
+
+      col_gather.reset();
+      col_gather.reset(new MpiPersistentAllgatherv(
+          mpi_comm_, col_buf.data(), gather_counts, gather_displs,
+          MpiBasicDatatype<T>()));
+
+      gather_panel = panel;
     }
 
-    // Broadcast the column below the diagonal.
-    for (int rank = 0; rank != mpi_comm_size; ++rank) {
-      const size_t row_first = row_groups[rank];
-      const size_t row_last = row_groups[rank + 1];
+    const auto part_j_row = lower.submat(j, 0, j, j - 1);
 
-      if (row_last == row_first) {
-        break;
-      }
+    lower(j, j) = std::sqrt(
+        a(j, j) - as_scalar(part_j_row * part_j_row.t()));
 
-      vector<T> part_col_buf(row_last - row_first);
-      auto below = lower.submat(row_first, j, row_last - 1, j);
+    // Index of the first owned row below the diagonal among the owned rows of
+    // this MPI process.
+    const size_t owned_first = j + 1 > static_cast<size_t>(mpi_rank) ?
+        (j + 1 - mpi_rank + mpi_comm_size - 1) / mpi_comm_size : 0;
+
+    if (owned_first < static_cast<size_t>(owned_counts[mpi_rank])) {
+      // Owned rows below the diagonal.
+      const arma::uvec rows = arma::regspace<arma::uvec>(
+          owned_first * mpi_comm_size + mpi_rank,
+          mpi_comm_size,
+          lower.n_rows - 1);
+
+      const Col<T> below =
+          (lower.submat(rows, arma::uvec{static_cast<arma::uword>(j)}) -
+           lower.submat(rows, arma::regspace<arma::uvec>(0, j - 1)) *
+           part_j_row.t()) / lower(j, j);
+
+      std::copy(
+          below.begin(), below.end(),
+          col_buf.begin() + owned_displs[mpi_rank] + owned_first);
+    }
 
-      // Store the part of the column solved by this MPI process in the
-      // broadcast buffer.
-      if (rank == mpi_rank) {
-        std::copy(below.begin(), below.end(), part_col_buf.begin());
-      }
+    col_gather->Run();
 
-      MPI_Bcast(
-          part_col_buf.data(),
-          part_col_buf.size(),
-          MpiBasicDatatype<T>(),
-          rank,
-          mpi_comm_);
+    // Get the column below the diagonal from the MPI processes that own the
+    // rows.
+    for (int rank = 0; rank != mpi_comm_size; ++rank) {
+      for (int k = gather_panel; k < owned_counts[rank]; ++k) {
+        const size_t i = static_cast<size_t>(k) * mpi_comm_size + rank;
 
-      // Get the part of the column solved by another MPI process.
-      if (rank != mpi_rank) {
-        std::copy(part_col_buf.begin(), part_col_buf.end(), below.begin());
+        if (i > j) {
+          lower(i, j) = col_buf[owned_displs[rank] + k];
+        }
       }
     }
   }
@@ -0,0 +1,81 @@
+#ifndef TANUKI_MATH_LINEAR_CHOLESKY_QR_H
+#define TANUKI_MATH_LINEAR_CHOLESKY_QR_H
+
+#include <armadillo>
+#include <mpi.h>
+
+#include "tanuki/math/linear/qr_decomposition.h"
+
+namespace tanuki {
+namespace math {
+namespace linear {
+
+/**
+ *  @brief Thin QR decomposition by CholeskyQR2 (Fukaya 2014).
+ *
+ *  A pass of CholeskyQR forms the Gram matrix, \f$ \mathbf{A}^{\dagger}
+ *  \mathbf{A} = \mathbf{R}^{\dagger} \mathbf{R} \f$, through @link
+ *  CholeskyDecomposition @endlink, and evaluates \f$ \mathbf{Q} = \mathbf{A}
+ *  \mathbf{R}^{-1} \f$ through @link BackSubstitute @endlink and @link
+ *  MatrixProduct @endlink. A second pass on Q restores the orthogonality lost
+ *  in the first pass. It is accurate for matrices whose condition number is
+ *  less than about \f$ \epsilon^{-1/2} \f$.
+ *
+ *  If any Gram matrix is not numerically positive definite, the
+ *  decomposition falls back to @link ThinIteratedGramSchmidt @endlink with
+ *  default values.
+ *
+ *  @tparam T
+ *    Type of elements in an Armadillo matrix. It must be @link
+ *    tanuki::number::real_t @endlink or @link tanuki::number::complex_t
+ *    @endlink.
+ *
+ *  @param mpi_comm
+ *    MPI communicator.
+ *
+ *  @param matrix
+ *    Matrix to decompose. Number of rows must be at least the number of
+ *    columns.
+ *
+ *  @return
+ *    Thin QR decomposition of <tt>matrix</tt>.
+ */
+template <typename T>
+QrDecomposition<T> CholeskyQr2(MPI_Comm mpi_comm, const arma::Mat<T> &matrix);
+
+/**
+ *  @brief Thin QR decomposition by shifted CholeskyQR3 (Fukaya 2020).
+ *
+ *  First pass of CholeskyQR is performed on the Gram matrix shifted by \f$ s
+ *  = 11 (m n + n (n + 1)) u \| \mathbf{A} \|_{F}^{2} \f$ for an \f$ m \times n
+ *  \f$ matrix, where \f$ u \f$ is the unit roundoff, and the result is
+ *  refined by @link CholeskyQr2 @endlink. It is accurate for matrices whose
+ *  condition number is less than about \f$ u^{-1} \f$.
+ *
+ *  Fallback is the same as that of @link CholeskyQr2 @endlink.
+ */
+template <typename T>
+QrDecomposition<T> ShiftedCholeskyQr3(
+    MPI_Comm mpi_comm, const arma::Mat<T> &matrix);
+
+/**
+ *  @brief Thin QR decomposition by CholeskyQR with the shift decided by the
+ *  condition number.
+ *
+ *  The condition number is estimated from the R factor of the first
+ *  unshifted pass. If it is small enough for @link CholeskyQr2 @endlink, the
+ *  first pass is reused for CholeskyQR2. Otherwise, @link ShiftedCholeskyQr3
+ *  @endlink is performed.
+ *
+ *  Fallback is the same as that of @link CholeskyQr2 @endlink.
+ */
+template <typename T>
+QrDecomposition<T> CholeskyQr(MPI_Comm mpi_comm, const arma::Mat<T> &matrix);
+
+} // namespace linear
+} // namespace math
+} // namespace tanuki
+
+#include "tanuki/math/linear/cholesky_qr.hxx"
+
+#endif
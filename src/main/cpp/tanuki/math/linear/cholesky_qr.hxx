@@ -0,0 +1,228 @@
+#ifndef TANUKI_MATH_LINEAR_CHOLESKY_QR_HXX
+#define TANUKI_MATH_LINEAR_CHOLESKY_QR_HXX
+
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <limits>
+
+#include "tanuki/math/linear/cholesky_decomposition.h"
+#include "tanuki/math/linear/iterated_gram_schmidt.h"
+#include "tanuki/math/linear/matrix_product.h"
+#include "tanuki/math/linear/triangular_matrix.h"
+#include "tanuki/number/types.h"
+
+namespace tanuki {
+namespace math {
+namespace linear {
+
+using arma::Mat;
+
+using tanuki::number::real_t;
+
+/**
+ *  @brief Internal class for CholeskyQR.
+ *
+ *  @private
+ */
+struct CholeskyQrImpl final {
+ public:
+  CholeskyQrImpl() = delete;
+
+  template <typename T>
+  friend QrDecomposition<T> CholeskyQr2(
+      MPI_Comm mpi_comm, const Mat<T> &matrix);
+
+  template <typename T>
+  friend QrDecomposition<T> ShiftedCholeskyQr3(
+      MPI_Comm mpi_comm, const Mat<T> &matrix);
+
+  template <typename T>
+  friend QrDecomposition<T> CholeskyQr(
+      MPI_Comm mpi_comm, const Mat<T> &matrix);
+
+ private:
+  /**
+   *  @brief Performs a pass of CholeskyQR.
+   *
+   *  @param mpi_comm
+   *    MPI communicator.
+   *
+   *  @param matrix
+   *    Matrix to decompose.
+   *
+   *  @param shift
+   *    Non-negative shift added to the diagonal of the Gram matrix.
+   *
+   *  @param [out] qr
+   *    Thin QR decomposition from the pass. It is valid only if
+   *    <tt>true</tt> is returned.
+   *
+   *  @return
+   *    Whether the (shifted) Gram matrix is numerically positive definite.
+   */
+  template <typename T>
+  static bool Pass(
+      MPI_Comm mpi_comm,
+      const Mat<T> &matrix,
+      real_t shift,
+      QrDecomposition<T> &qr) {
+    assert(shift >= 0.0);
+
+    Mat<T> gram(MatrixProduct(mpi_comm, Mat<T>(matrix.t()), matrix));
+
+    if (shift != 0.0) {
+      gram.diag() += T(shift);
+    }
+
+    CholeskyDecomposition<T> cholesky(gram, mpi_comm);
+
+    if (!IsPositiveDiagonal(cholesky.l())) {
+      return false;
+    }
+
+    qr.r = cholesky.lt();
+
+    // Inverse of R, which is upper triangular.
+    const Mat<T> r_inv(
+        BackSubstitute(
+            mpi_comm, qr.r,
+            Mat<T>(qr.r.n_rows, qr.r.n_cols, arma::fill::eye)));
+
+    qr.q = MatrixProduct(mpi_comm, matrix, r_inv);
+
+    return true;
+  }
+
+  /**
+   *  @brief Whether the diagonal of a Cholesky factor is real, positive, and
+   *  finite, which indicates that the decomposed matrix is numerically
+   *  positive definite.
+   */
+  template <typename T>
+  static bool IsPositiveDiagonal(const Mat<T> &factor) {
+    for (size_t j = 0; j != factor.n_cols; ++j) {
+      const auto diag_real = std::real(factor(j, j));
+      const auto diag_imag = std::imag(factor(j, j));
+
+      if (!std::isfinite(diag_real) || !std::isfinite(diag_imag) ||
+          diag_real <= 0.0 || std::abs(diag_imag) >= diag_real) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   *  @brief Lower bound of the condition number of an upper triangular
+   *  matrix from the magnitudes of its diagonal elements.
+   */
+  template <typename T>
+  static real_t CondEstimate(const Mat<T> &upper) {
+    real_t min_diag = std::numeric_limits<real_t>::max();
+    real_t max_diag = 0.0;
+
+    for (size_t j = 0; j != upper.n_cols; ++j) {
+      const real_t abs_diag = std::abs(upper(j, j));
+
+      min_diag = std::fmin(min_diag, abs_diag);
+      max_diag = std::fmax(max_diag, abs_diag);
+    }
+
+    return max_diag / min_diag;
+  }
+
+  /**
+   *  @brief Performs the second pass of CholeskyQR2 on the decomposition from
+   *  a previous pass.
+   *
+   *  @param qr
+   *    Decomposition from the previous pass. It is refined in place if
+   *    <tt>true</tt> is returned.
+   *
+   *  @return
+   *    Whether the Gram matrix of Q is numerically positive definite.
+   */
+  template <typename T>
+  static bool Refine(MPI_Comm mpi_comm, QrDecomposition<T> &qr) {
+    QrDecomposition<T> refined;
+
+    if (!Pass(mpi_comm, qr.q, 0.0, refined)) {
+      return false;
+    }
+
+    qr.q = std::move(refined.q);
+    qr.r = refined.r * qr.r;
+
+    return true;
+  }
+};
+
+template <typename T>
+QrDecomposition<T> CholeskyQr2(MPI_Comm mpi_comm, const Mat<T> &matrix) {
+  assert(matrix.n_rows >= matrix.n_cols);
+
+  QrDecomposition<T> retval;
+
+  if (!CholeskyQrImpl::Pass(mpi_comm, matrix, 0.0, retval) ||
+      !CholeskyQrImpl::Refine(mpi_comm, retval)) {
+    return ThinIteratedGramSchmidt(mpi_comm, matrix);
+  }
+
+  return retval;
+}
+
+template <typename T>
+QrDecomposition<T> ShiftedCholeskyQr3(
+    MPI_Comm mpi_comm, const Mat<T> &matrix) {
+  assert(matrix.n_rows >= matrix.n_cols);
+
+  // Unit roundoff.
+  const real_t unit_roundoff = std::numeric_limits<real_t>::epsilon() / 2.0;
+
+  const real_t m = matrix.n_rows;
+  const real_t n = matrix.n_cols;
+
+  const real_t fro_norm = arma::norm(matrix, "fro");
+
+  const real_t shift =
+      11.0 * (m * n + n * (n + 1.0)) * unit_roundoff * fro_norm * fro_norm;
+
+  QrDecomposition<T> retval;
+
+  if (!CholeskyQrImpl::Pass(mpi_comm, matrix, shift, retval) ||
+      !CholeskyQrImpl::Refine(mpi_comm, retval) ||
+      !CholeskyQrImpl::Refine(mpi_comm, retval)) {
+    return ThinIteratedGramSchmidt(mpi_comm, matrix);
+  }
+
+  return retval;
+}
+
+template <typename T>
+QrDecomposition<T> CholeskyQr(MPI_Comm mpi_comm, const Mat<T> &matrix) {
+  assert(matrix.n_rows >= matrix.n_cols);
+
+  // Condition number above which the shifted variant is used. It is an order
+  // of magnitude below the limit of CholeskyQR2, since the estimate is a lower
+  // bound.
+  const real_t max_cond =
+      0.1 / std::sqrt(std::numeric_limits<real_t>::epsilon());
+
+  QrDecomposition<T> retval;
+
+  if (CholeskyQrImpl::Pass(mpi_comm, matrix, 0.0, retval) &&
+      CholeskyQrImpl::CondEstimate(retval.r) < max_cond &&
+      CholeskyQrImpl::Refine(mpi_comm, retval)) {
+    return retval;
+  }
+
+  return ShiftedCholeskyQr3(mpi_comm, matrix);
+}
+
+} // namespace linear
+} // namespace math
+} // namespace tanuki
+
+#endif
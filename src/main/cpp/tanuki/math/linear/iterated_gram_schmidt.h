@@ -54,7 +54,9 @@ using tanuki::number::real_t;
  *    It must be positive.
  *
  *  @return
- *    QR decomposition of <tt>matrix</tt>.
+ *    Full QR decomposition of <tt>matrix</tt>. It is equivalent to @link
+ *    ThinIteratedGramSchmidt @endlink followed by @link
+ *    CompleteQrDecomposition @endlink.
  */
 template <typename T>
 QrDecomposition<T> IteratedGramSchmidt(
@@ -64,6 +66,121 @@ QrDecomposition<T> IteratedGramSchmidt(
     size_t max_reorthos = 1,
     real_t zero_norm_abs_thresh = 1.0e-5);
 
+/**
+ *  @brief Thin QR decomposition by iterated Gram-Schmidt process.
+ *
+ *  Unlike @link IteratedGramSchmidt @endlink, the matrix is not padded for
+ *  non-square input, and R is accumulated during the orthogonalization
+ *  instead of being recomputed afterwards. The decomposition can be completed
+ *  with @link CompleteQrDecomposition @endlink.
+ *
+ *  @tparam T
+ *    Type of elements in an Armadillo matrix. It must be @link
+ *    tanuki::number::real_t @endlink or @link tanuki::number::complex_t
+ *    @endlink.
+ *
+ *  @param mpi_comm
+ *    MPI communicator.
+ *
+ *  @param matrix
+ *    Matrix to decompose. Number of rows must be at least the number of
+ *    columns, and the columns must be linearly independent.
+ *
+ *  @param reortho_thresh_factor
+ *    See @link IteratedGramSchmidt @endlink.
+ *
+ *  @param max_reorthos
+ *    See @link IteratedGramSchmidt @endlink.
+ *
+ *  @return
+ *    Thin QR decomposition of <tt>matrix</tt>, where Q has the same size as
+ *    <tt>matrix</tt>, and R is a square matrix.
+ */
+template <typename T>
+QrDecomposition<T> ThinIteratedGramSchmidt(
+    MPI_Comm mpi_comm,
+    const arma::Mat<T> &matrix,
+    real_t reortho_thresh_factor = 0.5,
+    size_t max_reorthos = 1);
+
+/**
+ *  @brief Completes a thin QR decomposition to a full QR decomposition.
+ *
+ *  Q is completed to a square matrix by orthonormalizing columns of an
+ *  identity matrix against it using iterated Gram-Schmidt process, and R is
+ *  padded with zero rows at the bottom.
+ *
+ *  @tparam T
+ *    Type of elements in an Armadillo matrix. It must be @link
+ *    tanuki::number::real_t @endlink or @link tanuki::number::complex_t
+ *    @endlink.
+ *
+ *  @param mpi_comm
+ *    MPI communicator.
+ *
+ *  @param reortho_thresh_factor
+ *    See @link IteratedGramSchmidt @endlink.
+ *
+ *  @param max_reorthos
+ *    See @link IteratedGramSchmidt @endlink.
+ *
+ *  @param zero_norm_abs_thresh
+ *    See @link IteratedGramSchmidt @endlink.
+ *
+ *  @param qr
+ *    Thin QR decomposition to complete in place. If it is already a full
+ *    decomposition of a square matrix, it is left unchanged.
+ */
+template <typename T>
+void CompleteQrDecomposition(
+    MPI_Comm mpi_comm,
+    real_t reortho_thresh_factor,
+    size_t max_reorthos,
+    real_t zero_norm_abs_thresh,
+    QrDecomposition<T> &qr);
+
+/**
+ *  @brief Extends a thin QR decomposition with new columns by iterated
+ *  Gram-Schmidt process.
+ *
+ *  Only the new columns are orthogonalized, with reorthogonalizations as
+ *  needed, against the existing Q and then among themselves. Adding \f$ k
+ *  \f$ columns to an \f$ n \times m \f$ Q costs \f$ O(n m k + n k^2) \f$
+ *  instead of \f$ O(n (m + k)^2) \f$ for decomposing the whole matrix again.
+ *
+ *  @tparam T
+ *    Type of elements in an Armadillo matrix. It must be @link
+ *    tanuki::number::real_t @endlink or @link tanuki::number::complex_t
+ *    @endlink.
+ *
+ *  @param mpi_comm
+ *    MPI communicator.
+ *
+ *  @param new_cols
+ *    Columns to append to the decomposed matrix. Number of rows must be the
+ *    same as that of Q, and the total number of columns must not exceed the
+ *    number of rows. The new columns must be linearly independent of each
+ *    other and of the columns of Q.
+ *
+ *  @param reortho_thresh_factor
+ *    See @link IteratedGramSchmidt @endlink.
+ *
+ *  @param max_reorthos
+ *    See @link IteratedGramSchmidt @endlink.
+ *
+ *  @param qr
+ *    Thin QR decomposition, such as from @link ThinIteratedGramSchmidt
+ *    @endlink, to extend in place. If it is empty, it becomes the thin QR
+ *    decomposition of <tt>new_cols</tt>.
+ */
+template <typename T>
+void ExtendIteratedGramSchmidt(
+    MPI_Comm mpi_comm,
+    const arma::Mat<T> &new_cols,
+    real_t reortho_thresh_factor,
+    size_t max_reorthos,
+    QrDecomposition<T> &qr);
+
 } // namespace linear
 } // namespace math
 } // namespace tanuki
@@ -32,12 +32,27 @@ struct IteratedGramSchmidtImpl final {
   IteratedGramSchmidtImpl() = delete;
 
   template <typename T>
-  friend QrDecomposition<T> IteratedGramSchmidt(
+  friend QrDecomposition<T> ThinIteratedGramSchmidt(
       MPI_Comm mpi_comm,
       const Mat<T> &matrix,
       real_t reortho_thresh_factor,
+      size_t max_reorthos);
+
+  template <typename T>
+  friend void CompleteQrDecomposition(
+      MPI_Comm mpi_comm,
+      real_t reortho_thresh_factor,
+      size_t max_reorthos,
+      real_t zero_norm_abs_thresh,
+      QrDecomposition<T> &qr);
+
+  template <typename T>
+  friend void ExtendIteratedGramSchmidt(
+      MPI_Comm mpi_comm,
+      const Mat<T> &new_cols,
+      real_t reortho_thresh_factor,
       size_t max_reorthos,
-      real_t zero_norm_abs_thresh);
+      QrDecomposition<T> &qr);
 
  private:
   /**
@@ -62,6 +77,12 @@ struct IteratedGramSchmidtImpl final {
    *
    *  @param max_reorthos
    *    See @link IteratedGramSchmidt @endlink.
+   *
+   *  @param r
+   *    Pointer to the R factor, or <tt>nullptr</tt> if R is not accumulated.
+   *    If not <tt>nullptr</tt>, the projection coefficients and norms of the
+   *    columns in the subset are added to the upper triangle of the diagonal
+   *    block of the subset.
    */
   template <typename T>
   static void OrthonormalizeBlock(
@@ -69,7 +90,8 @@ struct IteratedGramSchmidtImpl final {
       size_t first,
       size_t last,
       real_t reortho_thresh_factor,
-      size_t max_reorthos) {
+      size_t max_reorthos,
+      Mat<T> *r) {
     assert(matrix.n_rows >= matrix.n_cols);
     assert(last >= first);
     assert(first >= 0 && last <= matrix.n_cols);
@@ -79,7 +101,15 @@ struct IteratedGramSchmidtImpl final {
     }
 
     // Normalize the first column in the block.
-    matrix.col(first) /= arma::norm(matrix.col(first));
+    {
+      const real_t first_norm = arma::norm(matrix.col(first));
+
+      matrix.col(first) /= first_norm;
+
+      if (r != nullptr) {
+        (*r)(first, first) = first_norm;
+      }
+    }
 
     // Iterate over the kets to be orthogonalized, starting from the second ket
     // in the block.
@@ -89,6 +119,9 @@ struct IteratedGramSchmidtImpl final {
       real_t q_k_pre_norm = arma::norm(q_k);
       real_t q_k_post_norm;
 
+      // Projection coefficients accumulated over the reorthogonalizations.
+      Col<T> r_k(k - first, arma::fill::zeros);
+
       size_t p = 0;
 
       // Orthogonalize the ket with reorthogonalizations as needed.
@@ -100,6 +133,7 @@ struct IteratedGramSchmidtImpl final {
           const Col<T> qrk(q_sub * s_k);
 
           q_k -= qrk;
+          r_k += s_k;
         }
 
         q_k_post_norm = arma::norm(q_k);
@@ -114,109 +148,350 @@ struct IteratedGramSchmidtImpl final {
 
       // Normalize the orthogonalized ket.
       q_k /= q_k_post_norm;
+
+      if (r != nullptr) {
+        r->submat(first, k, k - 1, k) += r_k;
+        (*r)(k, k) = q_k_post_norm;
+      }
     }
   }
-};
 
-template <typename T>
-QrDecomposition<T> IteratedGramSchmidt(
-    MPI_Comm mpi_comm,
-    const Mat<T> &matrix,
-    real_t reortho_thresh_factor,
-    size_t max_reorthos,
-    real_t zero_norm_abs_thresh) {
-  assert(matrix.n_rows >= matrix.n_cols);
-  assert(zero_norm_abs_thresh > 0.0);
+  /**
+   *  @brief Orthogonalizes a block of columns against orthonormal columns
+   *  with reorthogonalizations as needed.
+   *
+   *  @param basis
+   *    Orthonormal columns.
+   *
+   *  @param block
+   *    Columns to orthogonalize in place against <tt>basis</tt>. It must have
+   *    the same number of rows as <tt>basis</tt>.
+   *
+   *  @param reortho_thresh_factor
+   *    See @link IteratedGramSchmidt @endlink. It is applied to each column
+   *    in <tt>block</tt>, and the whole block is reorthogonalized if any
+   *    column needs it.
+   *
+   *  @param max_reorthos
+   *    See @link IteratedGramSchmidt @endlink.
+   *
+   *  @return
+   *    Projection coefficients accumulated over the reorthogonalizations,
+   *    where rows and columns correspond to <tt>basis</tt> and <tt>block</tt>,
+   *    respectively.
+   */
+  template <typename T>
+  static Mat<T> ProjectOut(
+      const Mat<T> &basis,
+      Mat<T> &block,
+      real_t reortho_thresh_factor,
+      size_t max_reorthos) {
+    assert(basis.n_rows == block.n_rows);
+
+    Mat<T> retval(basis.n_cols, block.n_cols, arma::fill::zeros);
 
-  int mpi_rank;
-  MPI_Comm_rank(mpi_comm, &mpi_rank);
+    // Norms of the columns before each projection.
+    vector<real_t> pre_norms(block.n_cols);
 
-  int mpi_comm_size;
-  MPI_Comm_size(mpi_comm, &mpi_comm_size);
+    for (size_t j = 0; j != block.n_cols; ++j) {
+      pre_norms[j] = arma::norm(block.col(j));
+    }
 
-  const auto &a = matrix;
+    for (size_t p = 0; ; ++p) {
+      const Mat<T> s(basis.t() * block);
 
-  QrDecomposition<T> retval;
-  auto &q = retval.q;
-  auto &r = retval.r;
+      block -= basis * s;
+      retval += s;
+
+      if (p == max_reorthos) {
+        break;
+      }
+
+      bool needs_reortho = false;
+
+      for (size_t j = 0; j != block.n_cols; ++j) {
+        const real_t post_norm = arma::norm(block.col(j));
+
+        if (post_norm <= pre_norms[j] * reortho_thresh_factor) {
+          needs_reortho = true;
+        }
+
+        pre_norms[j] = post_norm;
+      }
+
+      if (!needs_reortho) {
+        break;
+      }
+    }
 
-  if (a.is_square()) {
-    q = a;
-  } else {
-    // Append an identity matrix to the right.
-    q = arma::join_horiz(a, arma::eye<Mat<T>>(a.n_rows, a.n_rows - a.n_cols));
+    return retval;
   }
 
-  const auto block_idxs = common::divider::GroupIndices(
-      0, q.n_cols, mpi_comm_size);
+  /**
+   *  @brief Orthonormalizes the trailing columns of a matrix in place by
+   *  distributing blocks of columns across MPI processes.
+   *
+   *  @param mpi_comm
+   *    MPI communicator.
+   *
+   *  @param first_col
+   *    Index of the first column to orthonormalize. Columns before it must
+   *    already be orthonormal, and the trailing columns are orthogonalized
+   *    against them.
+   *
+   *  @param reortho_thresh_factor
+   *    See @link IteratedGramSchmidt @endlink.
+   *
+   *  @param max_reorthos
+   *    See @link IteratedGramSchmidt @endlink.
+   *
+   *  @param matrix
+   *    Matrix whose trailing columns are orthonormalized.
+   *
+   *  @param r
+   *    Pointer to the R factor, or <tt>nullptr</tt> if R is not accumulated.
+   *    If not <tt>nullptr</tt>, it must be a square matrix with as many
+   *    columns as <tt>matrix</tt>, and the columns of R that correspond to the
+   *    trailing columns must be zero-initialized.
+   */
+  template <typename T>
+  static void OrthonormalizeTrailing(
+      MPI_Comm mpi_comm,
+      size_t first_col,
+      real_t reortho_thresh_factor,
+      size_t max_reorthos,
+      Mat<T> &matrix,
+      Mat<T> *r) {
+    assert(first_col <= matrix.n_cols);
+
+    int mpi_rank;
+    MPI_Comm_rank(mpi_comm, &mpi_rank);
 
-  // Index range of the block associated with the rank of this MPI process.
-  const size_t rank_b_first = block_idxs[mpi_rank];
-  const size_t rank_b_last = block_idxs[mpi_rank + 1];
+    int mpi_comm_size;
+    MPI_Comm_size(mpi_comm, &mpi_comm_size);
 
-  // Sequentially orthonormalize each block, and update the remaining blocks.
-  for (int ortho_rank = 0; ortho_rank != mpi_comm_size; ++ortho_rank) {
-    // Index range of the block associated with the rank that is
-    // orthonormalizing it.
-    const size_t ortho_b_first = block_idxs[ortho_rank];
-    const size_t ortho_b_last = block_idxs[ortho_rank + 1];
+    auto &q = matrix;
 
-    if (ortho_b_last == ortho_b_first) {
-      break;
+    const auto block_idxs = common::divider::GroupIndices(
+        first_col, q.n_cols, mpi_comm_size);
+
+    // Index range of the block associated with the rank of this MPI process.
+    const size_t rank_b_first = block_idxs[mpi_rank];
+    const size_t rank_b_last = block_idxs[mpi_rank + 1];
+
+    // Block associated with this MPI process as an alias.
+    Mat<T> rank_block(
+        q.memptr() + rank_b_first * q.n_rows,
+        q.n_rows, rank_b_last - rank_b_first,
+        false, true);
+
+    // Orthogonalize the block against the columns that are already
+    // orthonormal.
+    if (first_col != 0 && rank_b_last != rank_b_first) {
+      const Mat<T> leading_cols(q.memptr(), q.n_rows, first_col, false, true);
+
+      const auto s = ProjectOut(
+          leading_cols, rank_block, reortho_thresh_factor, max_reorthos);
+
+      if (r != nullptr) {
+        r->submat(0, rank_b_first, first_col - 1, rank_b_last - 1) += s;
+      }
     }
 
-    if (mpi_rank == ortho_rank) {
-      IteratedGramSchmidtImpl::OrthonormalizeBlock(
-          q, ortho_b_first, ortho_b_last,
-          reortho_thresh_factor, max_reorthos);
+    // Sequentially orthonormalize each block, and update the remaining
+    // blocks.
+    for (int ortho_rank = 0; ortho_rank != mpi_comm_size; ++ortho_rank) {
+      // Index range of the block associated with the rank that is
+      // orthonormalizing it.
+      const size_t ortho_b_first = block_idxs[ortho_rank];
+      const size_t ortho_b_last = block_idxs[ortho_rank + 1];
+
+      if (ortho_b_last == ortho_b_first) {
+        break;
+      }
+
+      if (mpi_rank == ortho_rank) {
+        OrthonormalizeBlock(
+            q, ortho_b_first, ortho_b_last,
+            reortho_thresh_factor, max_reorthos, r);
+      }
+
+      // Broadcast the orthonormal block.
+      MPI_Bcast(
+          q.colptr(ortho_b_first),
+          (ortho_b_last - ortho_b_first) * q.n_rows,
+          MpiBasicDatatype<T>(),
+          ortho_rank,
+          mpi_comm);
+
+      // Only blocks after the orthonormalized block need to be updated.
+      if (mpi_rank > ortho_rank && rank_b_last != rank_b_first) {
+        // Orthonormalized block.
+        const Mat<T> ortho_block(
+            q.colptr(ortho_b_first),
+            q.n_rows, ortho_b_last - ortho_b_first,
+            false, true);
+
+        const auto s = ProjectOut(
+            ortho_block, rank_block, reortho_thresh_factor, max_reorthos);
+
+        if (r != nullptr) {
+          r->submat(
+              ortho_b_first, rank_b_first,
+              ortho_b_last - 1, rank_b_last - 1) += s;
+        }
+      }
     }
 
-    // Broadcast the orthonormal block.
-    MPI_Bcast(
-        q.colptr(ortho_b_first),
-        (ortho_b_last - ortho_b_first) * q.n_rows,
-        MpiBasicDatatype<T>(),
-        ortho_rank,
-        mpi_comm);
+    if (r == nullptr) {
+      return;
+    }
 
-    if (mpi_rank != ortho_rank && rank_b_last != rank_b_first) {
-      // Block associated with this MPI process.
-      auto rank_block = q.submat(
-          0, rank_b_first, q.n_rows - 1, rank_b_last - 1);
+    // Gather the columns of R, which are contiguous for each block.
+    vector<int> counts(mpi_comm_size);
+    vector<int> displs(mpi_comm_size);
 
-      // Orthonormalized block.
-      const auto ortho_block = q.submat(
-          0, ortho_b_first, q.n_rows - 1, ortho_b_last - 1);
+    for (int rank = 0; rank != mpi_comm_size; ++rank) {
+      counts[rank] = (block_idxs[rank + 1] - block_idxs[rank]) * r->n_rows;
+      displs[rank] = (block_idxs[rank] - first_col) * r->n_rows;
+    }
 
-      rank_block -= ortho_block * ortho_block.t() * rank_block;
+    if (first_col != r->n_cols) {
+      MPI_Allgatherv(
+          MPI_IN_PLACE, 0, MpiBasicDatatype<T>(),
+          r->colptr(first_col), counts.data(), displs.data(),
+          MpiBasicDatatype<T>(),
+          mpi_comm);
     }
   }
+};
+
+template <typename T>
+QrDecomposition<T> ThinIteratedGramSchmidt(
+    MPI_Comm mpi_comm,
+    const Mat<T> &matrix,
+    real_t reortho_thresh_factor,
+    size_t max_reorthos) {
+  assert(matrix.n_rows >= matrix.n_cols);
+
+  QrDecomposition<T> retval;
+  auto &q = retval.q;
+  auto &r = retval.r;
+
+  q = matrix;
+  r.zeros(matrix.n_cols, matrix.n_cols);
+
+  IteratedGramSchmidtImpl::OrthonormalizeTrailing(
+      mpi_comm, 0, reortho_thresh_factor, max_reorthos, q, &r);
+
+  return retval;
+}
+
+template <typename T>
+void CompleteQrDecomposition(
+    MPI_Comm mpi_comm,
+    real_t reortho_thresh_factor,
+    size_t max_reorthos,
+    real_t zero_norm_abs_thresh,
+    QrDecomposition<T> &qr) {
+  assert(qr.q.n_rows >= qr.q.n_cols);
+  assert(qr.r.is_square() && qr.r.n_rows == qr.q.n_cols);
+  assert(zero_norm_abs_thresh > 0.0);
+
+  auto &q = qr.q;
+  auto &r = qr.r;
+
+  if (q.is_square()) {
+    return;
+  }
+
+  // Number of columns in the thin decomposition.
+  const size_t num_thin_cols = q.n_cols;
+
+  // Append an identity matrix to the right.
+  q = arma::join_horiz(
+      q, arma::eye<Mat<T>>(q.n_rows, q.n_rows - num_thin_cols));
+
+  IteratedGramSchmidtImpl::OrthonormalizeTrailing(
+      mpi_comm, num_thin_cols, reortho_thresh_factor, max_reorthos,
+      q, static_cast<Mat<T> *>(nullptr));
 
   // Remove zero columns that come from the orthogonalization of the appended
   // identity matrix.
-  if (!q.is_square()) {
-    {
-      vector<uword> zero_col_idxs;
-      for (uword j = a.n_cols; j != q.n_cols; ++j) {
-        if (arma::norm(q.col(j)) < zero_norm_abs_thresh) {
-          zero_col_idxs.push_back(j);
-        }
+  {
+    vector<uword> zero_col_idxs;
+    for (uword j = num_thin_cols; j != q.n_cols; ++j) {
+      if (arma::norm(q.col(j)) < zero_norm_abs_thresh) {
+        zero_col_idxs.push_back(j);
       }
-      q.shed_cols(uvec(std::move(zero_col_idxs)));
     }
+    q.shed_cols(uvec(std::move(zero_col_idxs)));
+  }
 
-    // Remove any extraneous columns to make it a square matrix.
-    if (!q.is_square()) {
-      q.shed_cols(q.n_rows, q.n_cols - 1);
-    }
+  // Remove any extraneous columns to make it a square matrix.
+  if (!q.is_square()) {
+    q.shed_cols(q.n_rows, q.n_cols - 1);
+  }
+
+  // Pad R with zero rows at the bottom.
+  r = arma::join_vert(
+      r, arma::zeros<Mat<T>>(q.n_rows - num_thin_cols, num_thin_cols));
+}
+
+template <typename T>
+void ExtendIteratedGramSchmidt(
+    MPI_Comm mpi_comm,
+    const Mat<T> &new_cols,
+    real_t reortho_thresh_factor,
+    size_t max_reorthos,
+    QrDecomposition<T> &qr) {
+  auto &q = qr.q;
+  auto &r = qr.r;
+
+  if (new_cols.is_empty()) {
+    return;
   }
 
-  r = MatrixProduct(mpi_comm, Mat<T>(q.t()), a);
+  if (q.is_empty()) {
+    qr = ThinIteratedGramSchmidt(
+        mpi_comm, new_cols, reortho_thresh_factor, max_reorthos);
 
-  if (!r.is_square()) {
-    r.rows(r.n_cols, r.n_rows - 1).zeros();
+    return;
   }
 
+  assert(r.is_square() && r.n_rows == q.n_cols);
+  assert(new_cols.n_rows == q.n_rows);
+  assert(q.n_cols + new_cols.n_cols <= q.n_rows);
+
+  // Number of columns in the existing decomposition.
+  const size_t num_old_cols = q.n_cols;
+
+  q.insert_cols(num_old_cols, new_cols);
+
+  // Enlarge R with zeros while preserving the existing elements.
+  r.resize(q.n_cols, q.n_cols);
+
+  IteratedGramSchmidtImpl::OrthonormalizeTrailing(
+      mpi_comm, num_old_cols, reortho_thresh_factor, max_reorthos, q, &r);
+}
+
+template <typename T>
+QrDecomposition<T> IteratedGramSchmidt(
+    MPI_Comm mpi_comm,
+    const Mat<T> &matrix,
+    real_t reortho_thresh_factor,
+    size_t max_reorthos,
+    real_t zero_norm_abs_thresh) {
+  assert(matrix.n_rows >= matrix.n_cols);
+  assert(zero_norm_abs_thresh > 0.0);
+
+  auto retval = ThinIteratedGramSchmidt(
+      mpi_comm, matrix, reortho_thresh_factor, max_reorthos);
+
+  CompleteQrDecomposition(
+      mpi_comm, reortho_thresh_factor, max_reorthos, zero_norm_abs_thresh,
+      retval);
+
   return retval;
 }
 
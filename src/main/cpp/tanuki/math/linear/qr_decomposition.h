@@ -19,13 +19,18 @@ template <typename T>
 struct QrDecomposition final {
  public:
   /**
-   *  @brief Square matrix, Q, of the decomposition.
+   *  @brief Matrix, Q, of the decomposition.
+   *
+   *  It is a square matrix for a full decomposition, or it has the same size
+   *  as the decomposed matrix for a thin decomposition.
    */
   arma::Mat<T> q;
 
   /**
-   *  @brief Upper triangular matrix, R, of the decomposition with zero rows at
-   *  the bottom for any padding.
+   *  @brief Upper triangular matrix, R, of the decomposition.
+   *
+   *  For a full decomposition, it has zero rows at the bottom for any padding.
+   *  For a thin decomposition, it is a square matrix.
    */
   arma::Mat<T> r;
 };
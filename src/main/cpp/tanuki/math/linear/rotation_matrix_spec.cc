@@ -1,6 +1,7 @@
 #include "tanuki/math/linear/rotation_matrix_spec.h"
 
 #include <algorithm>
+#include <cassert>
 #include <stdexcept>
 
 namespace tanuki {
@@ -17,6 +18,30 @@ RotationMatrixSpec CreateIdentityRotation() {
   };
 }
 
+bool IsIdentityRotation(const RotationMatrixSpec &spec) {
+  return spec.cosine == 1.0 && spec.sine == 0.0;
+}
+
+void ApplyGivensRotation(
+    const RotationMatrixSpec &spec,
+    size_t n,
+    complex_t *x,
+    complex_t *y,
+    size_t inc) {
+  assert(inc > 0);
+
+  // Complex numbers are stored as arrays of their real and imaginary parts.
+  const auto x_parts = reinterpret_cast<real_t *>(x);
+  const auto y_parts = reinterpret_cast<real_t *>(y);
+
+  if (inc == 1) {
+    ApplyGivensRotation(spec, 2 * n, x_parts, y_parts);
+  } else {
+    ApplyGivensRotation(spec, n, x_parts, y_parts, 2 * inc);
+    ApplyGivensRotation(spec, n, x_parts + 1, y_parts + 1, 2 * inc);
+  }
+}
+
 Mat<real_t> CreateGivensRotation(
     const RotationMatrixSpec &spec,
     size_t size,
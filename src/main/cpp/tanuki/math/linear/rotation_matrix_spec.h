@@ -11,6 +11,7 @@ namespace tanuki {
 namespace math {
 namespace linear {
 
+using tanuki::number::complex_t;
 using tanuki::number::real_t;
 
 /**
@@ -35,6 +36,12 @@ struct RotationMatrixSpec final {
  */
 RotationMatrixSpec CreateIdentityRotation();
 
+/**
+ *  @brief Whether a specification is exactly that of an identity rotation
+ *  matrix.
+ */
+bool IsIdentityRotation(const RotationMatrixSpec &spec);
+
 /**
  *  @brief Sets the four elements of a Givens rotation matrix from a
  *  specification.
@@ -71,6 +78,66 @@ void SetGivensRotation(
     size_t row2,
     arma::Mat<T> &matrix);
 
+/**
+ *  @brief Applies a Givens rotation in place to a pair of vectors.
+ *
+ *  Each pair of elements, \f$ (x_{i}, y_{i}) \f$, becomes \f$ (c x_{i} - s
+ *  y_{i}, s x_{i} + c y_{i}) \f$, where \f$ c \f$ and \f$ s \f$ are the
+ *  cosine and sine, respectively. For two columns of a matrix, it is the same
+ *  as postmultiplying the columns by the transpose of the Givens rotation
+ *  matrix from @link CreateGivensRotation @endlink with <tt>row1</tt> less
+ *  than <tt>row2</tt>, but without forming the rotation matrix or copying the
+ *  columns.
+ *
+ *  @tparam T
+ *    Type of vector elements. Rotation is performed in the precision of the
+ *    elements.
+ *
+ *  @param spec
+ *    Specification of the rotation.
+ *
+ *  @param n
+ *    Number of elements in each vector.
+ *
+ *  @param x
+ *    Pointer to the first element of the vector that is rotated as the lesser
+ *    index.
+ *
+ *  @param y
+ *    Pointer to the first element of the vector that is rotated as the
+ *    greater index. Elements must not overlap with those of <tt>x</tt>.
+ *
+ *  @param inc
+ *    Positive stride between consecutive elements of each vector. A stride of
+ *    the number of rows of a column-major matrix rotates rows.
+ */
+template <typename T>
+void ApplyGivensRotation(
+    const RotationMatrixSpec &spec,
+    size_t n,
+    T *x,
+    T *y,
+    size_t inc = 1);
+
+/**
+ *  @brief Applies a Givens rotation in place to two complex vectors as real
+ *  vectors.
+ *
+ *  Since the rotation is real, the real and imaginary parts are rotated
+ *  independently. Contiguous complex vectors are therefore rotated as real
+ *  vectors of twice the length without mixed-type arithmetic, and strided
+ *  complex vectors are rotated as two strided real vectors of the real and
+ *  imaginary parts, respectively.
+ *
+ *  See the overload for real vectors for the parameters.
+ */
+void ApplyGivensRotation(
+    const RotationMatrixSpec &spec,
+    size_t n,
+    complex_t *x,
+    complex_t *y,
+    size_t inc = 1);
+
 /**
  *  @brief Creates a Givens rotation matrix from a specification.
  *
@@ -2,6 +2,7 @@
 #define TANUKI_MATH_LINEAR_ROTATION_MATRIX_SPEC_HXX
 
 #include <algorithm>
+#include <cassert>
 #include <stdexcept>
 
 namespace tanuki {
@@ -44,6 +45,42 @@ void SetGivensRotation(
   matrix(greater_row_index, lesser_row_index) = spec.sine;
 }
 
+template <typename T>
+void ApplyGivensRotation(
+    const RotationMatrixSpec &spec,
+    size_t n,
+    T *x,
+    T *y,
+    size_t inc) {
+  assert(inc > 0);
+
+  // Cosine and sine in the precision of the elements, so that
+  // single-precision vectors are rotated in single precision.
+  using pod_t = typename arma::get_pod_type<T>::result;
+
+  const pod_t cosine = spec.cosine;
+  const pod_t sine = spec.sine;
+
+  if (inc == 1) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+      const T x_i = x[i];
+      const T y_i = y[i];
+
+      x[i] = cosine * x_i - sine * y_i;
+      y[i] = sine * x_i + cosine * y_i;
+    }
+  } else {
+    for (size_t i = 0; i < n * inc; i += inc) {
+      const T x_i = x[i];
+      const T y_i = y[i];
+
+      x[i] = cosine * x_i - sine * y_i;
+      y[i] = sine * x_i + cosine * y_i;
+    }
+  }
+}
+
 } // namespace linear
 } // namespace math
 } // namespace tanuki
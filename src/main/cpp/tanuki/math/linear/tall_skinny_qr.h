@@ -0,0 +1,63 @@
+#ifndef TANUKI_MATH_LINEAR_TALL_SKINNY_QR_H
+#define TANUKI_MATH_LINEAR_TALL_SKINNY_QR_H
+
+#include <cstddef>
+
+#include <armadillo>
+#include <mpi.h>
+
+#include "tanuki/math/linear/qr_decomposition.h"
+
+namespace tanuki {
+namespace math {
+namespace linear {
+
+/**
+ *  @brief Communication-avoiding QR decomposition of a tall-skinny matrix
+ *  (TSQR).
+ *
+ *  Rows of the matrix are distributed across MPI processes. Each MPI process
+ *  performs a local QR decomposition of its block of rows, and the R factors
+ *  are combined up a binary reduction tree (Demmel 2012). Only R factors and
+ *  the corresponding blocks of the Q factors of the tree travel between MPI
+ *  processes, so that the communication volume is \f$ O(k^2 \log P) \f$ for
+ *  \f$ k \f$ columns and \f$ P \f$ MPI processes.
+ *
+ *  Signs (or phases) are chosen such that the diagonal of R is real and
+ *  non-negative.
+ *
+ *  @tparam T
+ *    Type of elements in an Armadillo matrix. It must be @link
+ *    tanuki::number::real_t @endlink or @link tanuki::number::complex_t
+ *    @endlink.
+ *
+ *  @param mpi_comm
+ *    MPI communicator.
+ *
+ *  @param matrix
+ *    Matrix to decompose. Number of rows must be at least the number of
+ *    columns. Each MPI process reads only the block of rows that is assigned
+ *    to it by @link tanuki::common::divider::GroupIndices @endlink.
+ *
+ *  @param is_q_explicit
+ *    Whether Q is explicitly formed as a whole at every MPI process. If
+ *    <tt>false</tt>, Q is left implicit in the distribution of rows, and @link
+ *    QrDecomposition::q @endlink contains only the block of rows of Q
+ *    associated with this MPI process, which avoids the final gathering of Q.
+ *
+ *  @return
+ *    Thin QR decomposition of <tt>matrix</tt>.
+ */
+template <typename T>
+QrDecomposition<T> TallSkinnyQr(
+    MPI_Comm mpi_comm,
+    const arma::Mat<T> &matrix,
+    bool is_q_explicit = true);
+
+} // namespace linear
+} // namespace math
+} // namespace tanuki
+
+#include "tanuki/math/linear/tall_skinny_qr.hxx"
+
+#endif
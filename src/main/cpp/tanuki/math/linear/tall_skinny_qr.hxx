@@ -0,0 +1,291 @@
+#ifndef TANUKI_MATH_LINEAR_TALL_SKINNY_QR_HXX
+#define TANUKI_MATH_LINEAR_TALL_SKINNY_QR_HXX
+
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "tanuki/common/divider/group_delimiter.h"
+#include "tanuki/parallel/mpi/mpi_basic_datatype.h"
+
+namespace tanuki {
+namespace math {
+namespace linear {
+
+using std::vector;
+
+using arma::Mat;
+
+using tanuki::common::divider::GroupIndices;
+using tanuki::parallel::mpi::MpiBasicDatatype;
+
+/**
+ *  @brief Internal class for TSQR.
+ *
+ *  @private
+ */
+struct TallSkinnyQrImpl final {
+ public:
+  TallSkinnyQrImpl() = delete;
+
+  template <typename T>
+  friend QrDecomposition<T> TallSkinnyQr(
+      MPI_Comm mpi_comm,
+      const Mat<T> &matrix,
+      bool is_q_explicit);
+
+ private:
+  /**
+   *  @brief Node of the reduction tree at which this MPI process combined its
+   *  R factor with that of another MPI process.
+   *
+   *  @tparam T
+   *    Type of elements in an Armadillo matrix.
+   */
+  template <typename T>
+  struct TreeNode final {
+   public:
+    /**
+     *  @brief Rank of the MPI process whose R factor was received.
+     */
+    int child_rank;
+
+    /**
+     *  @brief Number of rows of the R factor of this MPI process at the top
+     *  of the stacked R factors.
+     */
+    size_t num_top_rows;
+
+    /**
+     *  @brief Q factor of the stacked R factors.
+     */
+    Mat<T> q;
+  };
+
+  /**
+   *  @brief Economical QR decomposition of a local matrix.
+   *
+   *  @param matrix
+   *    Matrix to decompose. It must not be empty.
+   *
+   *  @param [out] q
+   *    Q factor.
+   *
+   *  @param [out] r
+   *    R factor.
+   */
+  template <typename T>
+  static void LocalQr(const Mat<T> &matrix, Mat<T> &q, Mat<T> &r) {
+    assert(!matrix.is_empty());
+
+    if (!arma::qr_econ(q, r, matrix)) {
+      throw std::runtime_error("Local QR decomposition failed.");
+    }
+  }
+
+  /**
+   *  @brief Copy of a contiguous range of rows, which can be empty.
+   */
+  template <typename T>
+  static Mat<T> RowRange(const Mat<T> &matrix, size_t first, size_t last) {
+    assert(first <= last && last <= matrix.n_rows);
+
+    if (last == first) {
+      return Mat<T>(0, matrix.n_cols);
+    }
+
+    return matrix.rows(first, last - 1);
+  }
+};
+
+template <typename T>
+QrDecomposition<T> TallSkinnyQr(
+    MPI_Comm mpi_comm,
+    const Mat<T> &matrix,
+    bool is_q_explicit) {
+  assert(!matrix.is_empty());
+  assert(matrix.n_rows >= matrix.n_cols);
+
+  using Node = TallSkinnyQrImpl::TreeNode<T>;
+
+  int mpi_rank;
+  MPI_Comm_rank(mpi_comm, &mpi_rank);
+
+  int mpi_comm_size;
+  MPI_Comm_size(mpi_comm, &mpi_comm_size);
+
+  const size_t num_cols = matrix.n_cols;
+
+  // Delimitation of rows by MPI process.
+  const auto row_batches = GroupIndices(0, matrix.n_rows, mpi_comm_size);
+
+  const size_t row_first = row_batches[mpi_rank];
+  const size_t row_last = row_batches[mpi_rank + 1];
+
+  // Q factor of the local block of rows.
+  Mat<T> local_q;
+
+  // R factor that is reduced up the tree.
+  Mat<T> r(0, num_cols);
+
+  if (row_last != row_first) {
+    TallSkinnyQrImpl::LocalQr(
+        TallSkinnyQrImpl::RowRange(matrix, row_first, row_last),
+        local_q, r);
+  }
+
+  // Nodes of the tree at which this MPI process combined R factors, from the
+  // leaves to the root.
+  vector<Node> nodes;
+
+  // Rank of the MPI process that this MPI process sent its R factor to, or
+  // -1 if this MPI process is the root.
+  int parent_rank = -1;
+
+  // Combine the R factors up the tree.
+  for (int stride = 1; stride < mpi_comm_size; stride <<= 1) {
+    if (mpi_rank % (2 * stride) != 0) {
+      parent_rank = mpi_rank - stride;
+
+      unsigned long long num_rows = r.n_rows;
+
+      MPI_Send(
+          &num_rows, 1, MPI_UNSIGNED_LONG_LONG, parent_rank, 0, mpi_comm);
+
+      MPI_Send(
+          r.memptr(), r.n_elem, MpiBasicDatatype<T>(),
+          parent_rank, 0, mpi_comm);
+
+      break;
+    }
+
+    const int child_rank = mpi_rank + stride;
+
+    if (child_rank >= mpi_comm_size) {
+      continue;
+    }
+
+    unsigned long long child_num_rows;
+
+    MPI_Recv(
+        &child_num_rows, 1, MPI_UNSIGNED_LONG_LONG,
+        child_rank, 0, mpi_comm, MPI_STATUS_IGNORE);
+
+    Mat<T> child_r(child_num_rows, num_cols);
+
+    MPI_Recv(
+        child_r.memptr(), child_r.n_elem, MpiBasicDatatype<T>(),
+        child_rank, 0, mpi_comm, MPI_STATUS_IGNORE);
+
+    const Mat<T> stacked_r(arma::join_vert(r, child_r));
+
+    Node node;
+    node.child_rank = child_rank;
+    node.num_top_rows = r.n_rows;
+
+    if (!stacked_r.is_empty()) {
+      TallSkinnyQrImpl::LocalQr(stacked_r, node.q, r);
+    } else {
+      node.q.set_size(0, 0);
+    }
+
+    nodes.push_back(std::move(node));
+  }
+
+  // Factor that transforms the Q factor of the subtree rooted at this MPI
+  // process into the corresponding rows of the Q factor of the matrix.
+  Mat<T> y;
+
+  if (parent_rank == -1) {
+    assert(r.n_rows == num_cols);
+
+    y.zeros(num_cols, num_cols);
+
+    // Make the diagonal of R real and non-negative.
+    for (size_t j = 0; j != num_cols; ++j) {
+      const auto abs_diag = std::abs(r(j, j));
+      const T phase = abs_diag != 0.0 ? r(j, j) / abs_diag : T(1.0);
+
+      r.row(j) /= phase;
+      y(j, j) = phase;
+    }
+  } else {
+    y.set_size(r.n_rows, num_cols);
+
+    MPI_Recv(
+        y.memptr(), y.n_elem, MpiBasicDatatype<T>(),
+        parent_rank, 0, mpi_comm, MPI_STATUS_IGNORE);
+  }
+
+  // Propagate the factors down the tree.
+  for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+    const Mat<T> z(
+        it->q.is_empty() ? Mat<T>(0, num_cols) : Mat<T>(it->q * y));
+
+    const auto child_y = TallSkinnyQrImpl::RowRange(
+        z, it->num_top_rows, z.n_rows);
+
+    MPI_Send(
+        child_y.memptr(), child_y.n_elem, MpiBasicDatatype<T>(),
+        it->child_rank, 0, mpi_comm);
+
+    y = TallSkinnyQrImpl::RowRange(z, 0, it->num_top_rows);
+  }
+
+  QrDecomposition<T> retval;
+  auto &q = retval.q;
+
+  // Block of rows of Q associated with this MPI process.
+  Mat<T> q_block(
+      row_last != row_first ? Mat<T>(local_q * y) : Mat<T>(0, num_cols));
+
+  // Distribute R from the root.
+  r.set_size(num_cols, num_cols);
+  MPI_Bcast(r.memptr(), r.n_elem, MpiBasicDatatype<T>(), 0, mpi_comm);
+  retval.r = std::move(r);
+
+  if (!is_q_explicit) {
+    q = std::move(q_block);
+    return retval;
+  }
+
+  // Number of elements and displacement of each block of rows of Q.
+  vector<int> counts(mpi_comm_size);
+  vector<int> displs(mpi_comm_size);
+
+  for (int rank = 0; rank != mpi_comm_size; ++rank) {
+    counts[rank] = (row_batches[rank + 1] - row_batches[rank]) * num_cols;
+    displs[rank] = row_batches[rank] * num_cols;
+  }
+
+  // Blocks of rows of Q in order of rank, each in column-major order.
+  Mat<T> q_blocks(matrix.n_rows, num_cols);
+
+  MPI_Allgatherv(
+      q_block.memptr(), q_block.n_elem, MpiBasicDatatype<T>(),
+      q_blocks.memptr(), counts.data(), displs.data(), MpiBasicDatatype<T>(),
+      mpi_comm);
+
+  q.set_size(matrix.n_rows, num_cols);
+
+  for (int rank = 0; rank != mpi_comm_size; ++rank) {
+    const size_t first = row_batches[rank];
+    const size_t last = row_batches[rank + 1];
+
+    if (last != first) {
+      q.rows(first, last - 1) = Mat<T>(
+          q_blocks.memptr() + displs[rank], last - first, num_cols);
+    }
+  }
+
+  return retval;
+}
+
+} // namespace linear
+} // namespace math
+} // namespace tanuki
+
+#endif
@@ -2,6 +2,7 @@
 #define TANUKI_MATH_LINEAR_WEIGHTED_ORTHOGONALIZATION_H
 
 #include <cstddef>
+#include <string>
 #include <vector>
 
 #include <armadillo>
@@ -11,6 +12,7 @@
 #include "tanuki/math/linear/rotation_matrix_spec.h"
 #include "tanuki/number/types.h"
 #include "tanuki/parallel/grs/actuator.h"
+#include "tanuki/parallel/grs/autotuner.h"
 
 namespace tanuki {
 namespace math {
@@ -53,7 +55,12 @@ using tanuki::number::real_t;
  *    that avoids division by a number that is too close to zero.
  *
  *  @param actuator
- *    Actuator of the parallelization strategy.
+ *    Actuator of the parallelization strategy. It must be one-sided from the
+ *    right. Matrix that it transforms is <tt>prelim_ortho_matrix</tt>
+ *    augmented at the top with the overlap of <tt>nonortho_matrix</tt> with
+ *    it, which is kept up to date by the rotations so that the rotation of
+ *    each pair is evaluated from four elements of the overlap. Convergence
+ *    checker of the actuator is therefore given the augmented matrices.
  *
  *  @return
  *    Result from GRS parallelization strategy.
@@ -71,7 +78,13 @@ parallel::grs::Result<T> WeightOrthogonalized(
  *  strategy.
  *
  *  Implementation uses @link parallel::grs::Actuator @endlink for its default
- *  parallelization strategy.
+ *  parallelization strategy with @link parallel::grs::AdaptiveRelaxation
+ *  @endlink starting from @link parallel::grs::GrsOneSidedRelaxParam
+ *  @endlink. If any weight is less than
+ *  <tt>zero_abs_thresh</tt>, the actuator uses @link
+ *  parallel::grs::ActiveSetOrdering @endlink so that pairs of such
+ *  zero-weight columns, whose rotations are identities, are never inquired
+ *  or applied.
  *
  *  @param mpi_comm
  *    MPI communicator. The level of thread support must be at least
@@ -90,6 +103,127 @@ parallel::grs::Result<T> WeightOrthogonalized(
     size_t max_sweeps = 100,
     real_t zero_abs_thresh = 1.0e-5);
 
+/**
+ *  @brief Orthogonalization with weights using a default parallelization
+ *  strategy that is warm-started from a given rotation.
+ *
+ *  It is intended for a sequence of similar problems, such as those of
+ *  successive SCF iterations, where the rotation from the previous problem is
+ *  nearly optimal for the current one. GRS starts from
+ *  <tt>prelim_ortho_matrix</tt> rotated by <tt>init_rotation</tt>, and the
+ *  rotations are not relaxed, so that it typically converges in one or two
+ *  sweeps. Otherwise, it is the same as the overload without an initial
+ *  rotation.
+ *
+ *  @param init_rotation
+ *    Unitary matrix by which <tt>prelim_ortho_matrix</tt> is rotated from the
+ *    right to give the starting point. Number of rows and columns must be the
+ *    number of columns in <tt>prelim_ortho_matrix</tt>. If it is not
+ *    unitary, its nearest unitary matrix is used instead, so that the
+ *    starting point is orthonormal. It is the accumulated rotation of a
+ *    previous result if the actuator accumulated it. Otherwise, for a
+ *    previous result from the preliminary orthonormalized matrix,
+ *    \f$ P \f$, it can be obtained as the product of the conjugate
+ *    transpose of \f$ P \f$ and the transform of the result.
+ */
+template <typename T>
+parallel::grs::Result<T> WeightOrthogonalized(
+    MPI_Comm mpi_comm,
+    const Mat<T> &nonortho_matrix,
+    const Mat<T> &prelim_ortho_matrix,
+    const vector<real_t> &weights,
+    const Mat<T> &init_rotation,
+    size_t max_sweeps = 100,
+    real_t zero_abs_thresh = 1.0e-5);
+
+/**
+ *  @brief Orthogonalization with weights using a default parallelization
+ *  strategy that is warm-started from a previous result.
+ *
+ *  Initial rotation is the accumulated rotation of <tt>prev_result</tt> if
+ *  the actuator accumulated it, or the product of the conjugate transpose of
+ *  <tt>prelim_ortho_matrix</tt> and the transform of <tt>prev_result</tt>
+ *  otherwise. Since <tt>prelim_ortho_matrix</tt> can differ from that of the
+ *  previous problem, such as between SCF iterations, the product is
+ *  generally not unitary and is replaced by its nearest unitary matrix.
+ *  Otherwise, it is the same as the overload with an initial rotation.
+ *
+ *  @param prev_result
+ *    Result of a previous problem of the same size from
+ *    <tt>prelim_ortho_matrix</tt>.
+ */
+template <typename T>
+parallel::grs::Result<T> WeightOrthogonalized(
+    MPI_Comm mpi_comm,
+    const Mat<T> &nonortho_matrix,
+    const Mat<T> &prelim_ortho_matrix,
+    const vector<real_t> &weights,
+    const parallel::grs::Result<T> &prev_result,
+    size_t max_sweeps = 100,
+    real_t zero_abs_thresh = 1.0e-5);
+
+/**
+ *  @brief Orthogonalization with weights using a default parallelization
+ *  strategy with tuned parameters.
+ *
+ *  Number of groups of rotation sets, maximum number of threads, and initial
+ *  relaxation parameter of the actuator are read from a tuning file by the
+ *  size of the problem and the layout of the MPI processes. If the file does
+ *  not have them, they are determined by @link parallel::grs::Autotune
+ *  @endlink over @link parallel::grs::CreateDefaultTuningGrid @endlink and
+ *  stored for later runs. Otherwise, it is the same as @link
+ *  WeightOrthogonalized @endlink with a default parallelization strategy.
+ *
+ *  It has a distinct name so that a path is not mistaken for the initial
+ *  rotation of the warm-started overload, since an Armadillo matrix can be
+ *  constructed from a string.
+ *
+ *  @param tuning_path
+ *    Path to the tuning file. See @link parallel::grs::TuningFile @endlink.
+ */
+template <typename T>
+parallel::grs::Result<T> TunedWeightOrthogonalized(
+    MPI_Comm mpi_comm,
+    const Mat<T> &nonortho_matrix,
+    const Mat<T> &prelim_ortho_matrix,
+    const vector<real_t> &weights,
+    const std::string &tuning_path,
+    size_t max_sweeps = 100,
+    real_t zero_abs_thresh = 1.0e-5);
+
+/**
+ *  @brief Orthogonalization with weights of several independent problems
+ *  together using a default parallelization strategy.
+ *
+ *  It is intended for problems of the same size, such as those of the two
+ *  spins or of several fragments. The problems are actuated together by one
+ *  actuator through @link parallel::grs::Actuator::Actuate @endlink for
+ *  several problems, so that they share the setup and the communication of
+ *  each group of rotation sets. Convergence is checked on all problems
+ *  together. Otherwise, each problem is the same as with the overload for a
+ *  single problem.
+ *
+ *  @param nonortho_matrices
+ *    Nonorthogonal matrix of each problem. All must have the same size.
+ *
+ *  @param prelim_ortho_matrices
+ *    Orthogonal matrix of each problem whose columns are to be rotated.
+ *
+ *  @param weights
+ *    Orthogonalization weights of each problem.
+ *
+ *  @return
+ *    Result of each problem.
+ */
+template <typename T>
+vector<parallel::grs::Result<T>> WeightOrthogonalized(
+    MPI_Comm mpi_comm,
+    const vector<Mat<T>> &nonortho_matrices,
+    const vector<Mat<T>> &prelim_ortho_matrices,
+    const vector<vector<real_t>> &weights,
+    size_t max_sweeps = 100,
+    real_t zero_abs_thresh = 1.0e-5);
+
 } // namespace linear
 } // namespace math
 } // namespace tanuki
@@ -1,104 +1,348 @@
 #ifndef TANUKI_MATH_LINEAR_WEIGHTED_ORTHOGONALIZATION_HXX
 #define TANUKI_MATH_LINEAR_WEIGHTED_ORTHOGONALIZATION_HXX
 
+#include <algorithm>
 #include <cassert>
+#include <memory>
 
 #include "tanuki/parallel/grs/actuator.h"
 #include "tanuki/parallel/grs/jacobi_sidedness.h"
+#include "tanuki/parallel/grs/pair_ordering.h"
 
 namespace tanuki {
 namespace math {
 namespace linear {
 
-using arma::Col;
-using arma::as_scalar;
-
 using math::linear::CreateIdentityRotation;
+using math::linear::MatrixIndexPair;
+using parallel::grs::ActiveSetOrdering;
+using parallel::grs::AdaptiveRelaxation;
+using parallel::grs::CreateDefaultTuningGrid;
+using parallel::grs::CreateTuningKey;
 using parallel::grs::GrsOneSidedRelaxParam;
 using parallel::grs::JacobiSidedness;
+using parallel::grs::PairOrdering;
+using parallel::grs::TunedParams;
+using parallel::grs::TuningParams;
 
 using tanuki::number::complex_t;
 
 namespace {
 
   /**
-   *  @brief Callback function that evaluates the angle to rotate two columns.
+   *  @brief Evaluates the rotation of two columns from the coefficients of
+   *  West 2014.
+   *
+   *  @param B
+   *    \f$ B \f$ coefficient.
+   *
+   *  @param C
+   *    \f$ C \f$ coefficient.
+   *
+   *  @param zero_abs_thresh
+   *    Absolute threshold for deciding whether the \f$ A \f$ coefficient is
+   *    close enough to zero.
+   *
+   *  @return
+   *    Specification of the rotation matrix for the two columns.
+   */
+  inline RotationMatrixSpec rotate(
+      complex_t B, complex_t C, real_t zero_abs_thresh) {
+    // A coefficient.
+    const auto A = sqrt(B * B + C * C);
+
+    // Do not rotate if the A coefficient is close enough to zero.
+    if (abs(A) < zero_abs_thresh) {
+      return CreateIdentityRotation();
+    }
+
+    return {
+      .cosine = (B / A).real(),
+      .sine = (C / A).real()
+    };
+  }
+
+  /**
+   *  @brief Callback function that evaluates the angles to rotate a batch of
+   *  column pairs from the overlaps.
    *
    *  @tparam T
    *    Type of elements in an Armadillo matrix.
    *
-   *  @param norm_col1
-   *    Nonorthogonal column that is normalized.
+   *  @param weights
+   *    Non-negative orthogonalization weights of the columns.
    *
-   *  @param ortho_col1
-   *    Orthonormalized column to rotate. It must have the same number of rows
-   *    as there are in <tt>norm_col1</tt>.
+   *  @param zero_abs_thresh
+   *    Absolute threshold for deciding whether a weight or the \f$ A \f$
+   *    coefficient is close enough to zero.
    *
-   *  @param weight1
-   *    Non-negative orthogonalization weight for <tt>ortho_col1</tt>.
+   *  @param index_pairs
+   *    Two-row matrix whose columns are the pairs of column indices.
    *
-   *  @param norm_col2
-   *    Another column as that of <tt>norm_col1</tt>.
+   *  @param augmented_matrix
+   *    Orthonormalized matrix whose columns are to be rotated, augmented at
+   *    the top with its overlap with the nonorthogonal matrix, where the
+   *    overlap is the square matrix whose element at row \f$ i \f$ and
+   *    column \f$ j \f$ is the inner product of nonorthogonal column
+   *    \f$ i \f$ with orthonormalized column \f$ j \f$.
    *
-   *  @param ortho_col2
-   *    Another column as that of <tt>ortho_col1</tt> for <tt>norm_col2</tt>.
+   *  @param rotation_specs
+   *    Specifications of the rotation matrices to fill in corresponding order
+   *    to <tt>index_pairs</tt>.
+   */
+  template <typename T>
+  void rotate_batch(
+      const vector<real_t> &weights,
+      real_t zero_abs_thresh,
+      const Mat<arma::uword> &index_pairs,
+      const Mat<T> &augmented_matrix,
+      vector<RotationMatrixSpec> &rotation_specs) {
+    assert(augmented_matrix.n_rows > augmented_matrix.n_cols);
+    assert(index_pairs.n_rows == 2);
+    assert(rotation_specs.size() == index_pairs.n_cols);
+
+    // Overlap matrix that is rotated along with the orthonormalized columns.
+    const auto &overlap = augmented_matrix;
+
+    for (size_t p = 0; p != index_pairs.n_cols; ++p) {
+      const auto i = index_pairs(0, p);
+      const auto j = index_pairs(1, p);
+
+      const auto weight1 = weights[i];
+      const auto weight2 = weights[j];
+
+      assert(weight1 >= 0.0);
+      assert(weight2 >= 0.0);
+
+      // Do not rotate if both weights are close enough to zero.
+      if (weight1 < zero_abs_thresh && weight2 < zero_abs_thresh) {
+        rotation_specs[p] = CreateIdentityRotation();
+        continue;
+      }
+
+      // B coefficient.
+      const complex_t B = weight1 * overlap(i, i) + weight2 * overlap(j, j);
+
+      // C coefficient.
+      const complex_t C = weight2 * overlap(j, i) - weight1 * overlap(i, j);
+
+      rotation_specs[p] = rotate(B, C, zero_abs_thresh);
+    }
+  }
+
+  /**
+   *  @brief Nearest unitary matrix to a square matrix, which is the unitary
+   *  factor of its polar decomposition from its singular value
+   *  decomposition.
    *
-   *  @param weight2
-   *    Another weight as that of <tt>weight1</tt> for <tt>orthonorm_col2</tt>.
+   *  GRS rotations preserve the inner products of the columns, so a starting
+   *  rotation that is not unitary would not be corrected.
+   */
+  template <typename T>
+  Mat<T> nearest_unitary(const Mat<T> &matrix) {
+    assert(matrix.is_square());
+
+    Mat<T> left_sing_vecs;
+    Mat<T> right_sing_vecs;
+    arma::Col<typename arma::get_pod_type<T>::result> sing_vals;
+
+    arma::svd(left_sing_vecs, sing_vals, right_sing_vecs, matrix);
+
+    return left_sing_vecs * right_sing_vecs.t();
+  }
+
+  /**
+   *  @brief Orthonormalized matrix augmented at the top with its overlap with
+   *  the nonorthogonal matrix.
    *
-   *  @return
-   *    Specification of the rotation matrix for <tt>ortho_col1</tt> and
-   *    <tt>ortho_col2</tt>, respectively.
+   *  A rotation of two columns rotates the same columns of the overlap, so
+   *  the overlap is kept up to date by the actuator without being
+   *  recomputed.
    */
   template <typename T>
-  RotationMatrixSpec rotate(
-      const Col<T> &norm_col1,
-      const Col<T> &ortho_col1,
-      real_t weight1,
-      const Col<T> &norm_col2,
-      const Col<T> &ortho_col2,
-      real_t weight2,
-      real_t zero_abs_thresh) {
-    assert(
-        norm_col1.n_rows == norm_col2.n_rows &&
-        norm_col1.n_rows == ortho_col1.n_rows &&
-        norm_col2.n_rows == ortho_col2.n_rows);
-    assert(weight1 >= 0.0);
-    assert(weight2 >= 0.0);
-
-    // Do not rotate if both weights are close enough to zero.
-    if (weight1 < zero_abs_thresh && weight2 < zero_abs_thresh) {
-      return CreateIdentityRotation();
+  Mat<T> augmented_ortho_matrix(
+      const Mat<T> &nonortho_matrix, const Mat<T> &ortho_matrix) {
+    return arma::join_vert(nonortho_matrix.t() * ortho_matrix, ortho_matrix);
+  }
+
+  /**
+   *  @brief Batched inquiry function of WO on augmented matrices.
+   */
+  template <typename T>
+  typename Actuator<T>::BatchInquiryFn augmented_inquiry_fn(
+      const vector<real_t> &weights, real_t zero_abs_thresh) {
+    return [&weights, zero_abs_thresh](
+        MatrixIndexPair::PairType pair_type,
+        const Mat<arma::uword> &index_pairs,
+        const Mat<T> &matrix,
+        vector<RotationMatrixSpec> &rotation_specs) -> void {
+      assert(pair_type == MatrixIndexPair::PairType::COLUMNS);
+
+      rotate_batch(
+          weights, zero_abs_thresh, index_pairs, matrix, rotation_specs);
+    };
+  }
+
+  /**
+   *  @brief Default ordering of the column pairs for the given weights.
+   *
+   *  Rotations of pairs of zero-weight columns are identities, so only pairs
+   *  with at least one weighted column are rotated.
+   *
+   *  @return
+   *    @link ActiveSetOrdering @endlink if any weight is close enough to
+   *    zero, or null otherwise.
+   */
+  inline std::shared_ptr<PairOrdering> default_ordering(
+      const vector<real_t> &weights, real_t zero_abs_thresh) {
+    // Whether each column has a weight that is not close enough to zero.
+    vector<bool> is_weighted(weights.size());
+
+    std::transform(
+        weights.begin(), weights.end(), is_weighted.begin(),
+        [zero_abs_thresh](real_t weight) -> bool {
+          return weight >= zero_abs_thresh;
+        });
+
+    if (std::all_of(is_weighted.begin(), is_weighted.end(),
+                    [](bool b) -> bool { return b; })) {
+      return nullptr;
     }
 
-    // Intermediate values for the B coefficient.
-    const auto B1 = weight1 * as_scalar(norm_col1.t() * ortho_col1);
-    const auto B2 = weight2 * as_scalar(norm_col2.t() * ortho_col2);
+    return std::make_shared<ActiveSetOrdering>(is_weighted);
+  }
 
-    // B coefficient.
-    const complex_t B = B1 + B2;
+  /**
+   *  @brief Relaxation function of the default parallelization strategy.
+   *
+   *  It halves the relaxation parameter after sweeping each group of
+   *  rotation sets, and it is superseded by the adaptive relaxation policy.
+   */
+  inline real_t default_relax_fn(size_t, real_t prev_relax, size_t) {
+    return prev_relax * 0.5;
+  }
 
-    // Intermediate values for the C coefficient.
-    const auto C1 = weight2 * as_scalar(norm_col2.t() * ortho_col1);
-    const auto C2 = -weight1 * as_scalar(norm_col1.t() * ortho_col2);
+  /**
+   *  @brief Options of the GRS actuator of the default parallelization
+   *  strategy.
+   *
+   *  @param ordering
+   *    Ordering of the column pairs, or null for the default of the actuator.
+   */
+  inline parallel::grs::ActuatorOptions default_actuator_options(
+      std::shared_ptr<PairOrdering> ordering) {
+    parallel::grs::ActuatorOptions retval;
 
-    // C coefficient.
-    const complex_t C = C1 + C2;
+    // Relaxation is decreased on progress of each group and increased toward
+    // the initial relaxation parameter on oscillation.
+    retval.relaxation_policy = std::make_shared<AdaptiveRelaxation>();
 
-    // A coefficient.
-    const auto A = sqrt(B * B + C * C);
+    retval.ordering = ordering;
 
-    // Do not rotate if the A coefficient is close enough to zero.
-    if (abs(A) < zero_abs_thresh) {
-      return CreateIdentityRotation();
-    }
+    return retval;
+  }
+
+  /**
+   *  @brief Default parameters of the GRS actuator, which has a group of
+   *  rotation sets for each MPI process and uses all threads.
+   */
+  inline TuningParams default_tuning_params(
+      MPI_Comm mpi_comm, real_t init_relax) {
+    int mpi_comm_size;
+    MPI_Comm_size(mpi_comm, &mpi_comm_size);
 
     return {
-      .cosine = (B / A).real(),
-      .sine = (C / A).real()
+      .num_groups = static_cast<size_t>(mpi_comm_size),
+      .max_threads = static_cast<size_t>(omp_get_max_threads()),
+      .init_relax = init_relax
     };
   }
 
+  /**
+   *  @brief Creates the GRS actuator of the default parallelization strategy
+   *  for augmented matrices.
+   *
+   *  @param num_overlap_rows
+   *    Number of rows of the overlap at the top of the augmented matrices.
+   *
+   *  @param params
+   *    Parameters of the actuator. Maximum number of threads is limited to
+   *    <tt>omp_get_max_threads()</tt>.
+   *
+   *  @param ordering
+   *    Ordering of the column pairs, or null for the default of the actuator.
+   */
+  template <typename T>
+  std::unique_ptr<Actuator<T>> create_default_actuator(
+      MPI_Comm mpi_comm,
+      size_t num_overlap_rows,
+      const TuningParams &params,
+      size_t max_sweeps,
+      real_t zero_abs_thresh,
+      std::shared_ptr<PairOrdering> ordering) {
+    assert(max_sweeps > 0);
+
+    // Function that determines whether GRS has converged from the
+    // orthonormalized columns without the overlap.
+    auto convergence_checker = [zero_abs_thresh, num_overlap_rows](
+        const Mat<T> &prev, const Mat<T> &curr) -> bool {
+      return norm(
+          curr.tail_rows(curr.n_rows - num_overlap_rows) -
+              prev.tail_rows(prev.n_rows - num_overlap_rows),
+          "fro") < zero_abs_thresh;
+    };
+
+    return std::unique_ptr<Actuator<T>>(
+        new Actuator<T>(
+            mpi_comm,
+            std::min<size_t>(params.max_threads, omp_get_max_threads()),
+            JacobiSidedness::ONE_SIDED_RIGHT,
+            params.init_relax,
+            params.num_groups,
+            max_sweeps,
+            default_relax_fn,
+            convergence_checker,
+            default_actuator_options(ordering)));
+  }
+
+  /**
+   *  @brief WO using the default parallelization strategy from a given
+   *  orthonormalized matrix and initial relaxation parameter.
+   *
+   *  @tparam T
+   *    Type of elements in an Armadillo matrix.
+   *
+   *  @param init_ortho_matrix
+   *    Orthonormalized matrix from which GRS starts.
+   *
+   *  @param init_relax
+   *    Initial relaxation parameter for GRS.
+   */
+  template <typename T>
+  parallel::grs::Result<T> default_weight_orthogonalized(
+      MPI_Comm mpi_comm,
+      const Mat<T> &nonortho_matrix,
+      const Mat<T> &init_ortho_matrix,
+      const vector<real_t> &weights,
+      real_t init_relax,
+      size_t max_sweeps,
+      real_t zero_abs_thresh) {
+    const auto actuator = create_default_actuator<T>(
+        mpi_comm,
+        nonortho_matrix.n_cols,
+        default_tuning_params(mpi_comm, init_relax),
+        max_sweeps,
+        zero_abs_thresh,
+        default_ordering(weights, zero_abs_thresh));
+
+    return WeightOrthogonalized(
+        nonortho_matrix,
+        init_ortho_matrix,
+        weights,
+        zero_abs_thresh,
+        *actuator);
+  }
+
 }
 
 template <typename T>
@@ -119,27 +363,17 @@ parallel::grs::Result<T> WeightOrthogonalized(
           weights.begin(), weights.end(),
           [](const real_t &weight) -> bool { return weight >= 0.0; }));
 
-  // Inquiry function for the GRS actuator.
-  auto inquiry_fn = [&nonortho_matrix, &weights, zero_abs_thresh](
-      const IndexedVectorPair<T> &vectors) -> RotationMatrixSpec {
-    const auto &first_idx = vectors.indices.first;
-    const auto &second_idx = vectors.indices.second;
-
-    return rotate(
-        Col<T>(
-            const_cast<T *>(nonortho_matrix.colptr(first_idx)),
-            nonortho_matrix.n_rows, false, true),
-        vectors.first,
-        weights[first_idx],
-        Col<T>(
-            const_cast<T *>(nonortho_matrix.colptr(second_idx)),
-            nonortho_matrix.n_rows, false, true),
-        vectors.second,
-        weights[second_idx],
-        zero_abs_thresh);
-  };
+  // Number of columns, which is also the number of rows of the overlap.
+  const size_t num_cols = nonortho_matrix.n_cols;
 
-  return actuator.Actuate(prelim_ortho_matrix, inquiry_fn);
+  auto retval = actuator.Actuate(
+      augmented_ortho_matrix(nonortho_matrix, prelim_ortho_matrix),
+      augmented_inquiry_fn<T>(weights, zero_abs_thresh));
+
+  // Remove the overlap from the transformed matrix.
+  retval.transform.shed_rows(0, num_cols - 1);
+
+  return retval;
 }
 
 template <typename T>
@@ -150,44 +384,177 @@ parallel::grs::Result<T> WeightOrthogonalized(
     const vector<real_t> &weights,
     size_t max_sweeps,
     real_t zero_abs_thresh) {
-  assert(max_sweeps > 0);
+  return default_weight_orthogonalized(
+      mpi_comm,
+      nonortho_matrix,
+      prelim_ortho_matrix,
+      weights,
+      GrsOneSidedRelaxParam(prelim_ortho_matrix.n_cols),
+      max_sweeps,
+      zero_abs_thresh);
+}
 
-  int mpi_comm_size;
-  MPI_Comm_size(mpi_comm, &mpi_comm_size);
+template <typename T>
+parallel::grs::Result<T> WeightOrthogonalized(
+    MPI_Comm mpi_comm,
+    const Mat<T> &nonortho_matrix,
+    const Mat<T> &prelim_ortho_matrix,
+    const vector<real_t> &weights,
+    const Mat<T> &init_rotation,
+    size_t max_sweeps,
+    real_t zero_abs_thresh) {
+  assert(init_rotation.is_square());
+  assert(init_rotation.n_rows == prelim_ortho_matrix.n_cols);
 
-  // Function that determines whether GRS has converged.
-  auto convergence_checker =
-      [zero_abs_thresh](const Mat<T> &prev, const Mat<T> &curr) -> bool {
-        return norm(curr - prev, "fro") < zero_abs_thresh;
-      };
+  // Rotations from a nearly optimal starting point are small and hardly
+  // interfere with one another, so they are not relaxed.
+  return default_weight_orthogonalized(
+      mpi_comm,
+      nonortho_matrix,
+      Mat<T>(prelim_ortho_matrix * nearest_unitary(init_rotation)),
+      weights,
+      0.0,
+      max_sweeps,
+      zero_abs_thresh);
+}
 
-  // Initial relaxation parameter for GRS.
-  const auto init_relax_param =
-      GrsOneSidedRelaxParam(prelim_ortho_matrix.n_cols);
+template <typename T>
+parallel::grs::Result<T> WeightOrthogonalized(
+    MPI_Comm mpi_comm,
+    const Mat<T> &nonortho_matrix,
+    const Mat<T> &prelim_ortho_matrix,
+    const vector<real_t> &weights,
+    const parallel::grs::Result<T> &prev_result,
+    size_t max_sweeps,
+    real_t zero_abs_thresh) {
+  if (!prev_result.rotation.is_empty()) {
+    assert(prev_result.rotation.is_square());
+    assert(prev_result.rotation.n_rows == prelim_ortho_matrix.n_cols);
 
-  // Function that halves the relaxation parameter after sweeping each group of
-  // rotation sets.
-  auto relax_fn = [](size_t, real_t prev_relax, size_t) -> real_t {
-    return prev_relax * 0.5;
-  };
+    return WeightOrthogonalized(
+        mpi_comm,
+        nonortho_matrix,
+        prelim_ortho_matrix,
+        weights,
+        prev_result.rotation,
+        max_sweeps,
+        zero_abs_thresh);
+  }
 
-  // Create the default GRS actuator for WO.
-  parallel::grs::Actuator<T> actuator(
+  assert(arma::size(prev_result.transform) == arma::size(prelim_ortho_matrix));
+
+  return WeightOrthogonalized(
       mpi_comm,
-      omp_get_max_threads(),
+      nonortho_matrix,
+      prelim_ortho_matrix,
+      weights,
+      Mat<T>(prelim_ortho_matrix.t() * prev_result.transform),
+      max_sweeps,
+      zero_abs_thresh);
+}
+
+template <typename T>
+parallel::grs::Result<T> TunedWeightOrthogonalized(
+    MPI_Comm mpi_comm,
+    const Mat<T> &nonortho_matrix,
+    const Mat<T> &prelim_ortho_matrix,
+    const vector<real_t> &weights,
+    const std::string &tuning_path,
+    size_t max_sweeps,
+    real_t zero_abs_thresh) {
+  const auto augmented_matrix =
+      augmented_ortho_matrix(nonortho_matrix, prelim_ortho_matrix);
+
+  const auto ordering = default_ordering(weights, zero_abs_thresh);
+
+  // Tunings are keyed by the shape of the problem rather than that of the
+  // augmented matrix.
+  const auto params = TunedParams<T>(
+      mpi_comm,
+      tuning_path,
+      CreateTuningKey(
+          mpi_comm, prelim_ortho_matrix.n_rows, prelim_ortho_matrix.n_cols),
       JacobiSidedness::ONE_SIDED_RIGHT,
-      init_relax_param,
-      mpi_comm_size,
+      augmented_matrix,
+      augmented_inquiry_fn<T>(weights, zero_abs_thresh),
+      default_relax_fn,
+      default_actuator_options(ordering),
+      CreateDefaultTuningGrid(mpi_comm, prelim_ortho_matrix.n_cols));
+
+  const auto actuator = create_default_actuator<T>(
+      mpi_comm,
+      nonortho_matrix.n_cols,
+      params,
       max_sweeps,
-      relax_fn,
-      convergence_checker);
+      zero_abs_thresh,
+      ordering);
 
   return WeightOrthogonalized(
       nonortho_matrix,
       prelim_ortho_matrix,
       weights,
       zero_abs_thresh,
-      actuator);
+      *actuator);
+}
+
+template <typename T>
+vector<parallel::grs::Result<T>> WeightOrthogonalized(
+    MPI_Comm mpi_comm,
+    const vector<Mat<T>> &nonortho_matrices,
+    const vector<Mat<T>> &prelim_ortho_matrices,
+    const vector<vector<real_t>> &weights,
+    size_t max_sweeps,
+    real_t zero_abs_thresh) {
+  assert(!nonortho_matrices.empty());
+  assert(prelim_ortho_matrices.size() == nonortho_matrices.size());
+  assert(weights.size() == nonortho_matrices.size());
+  assert(zero_abs_thresh > 0.0);
+
+  const size_t num_problems = nonortho_matrices.size();
+
+  // Number of columns of each problem, which is also the number of rows of
+  // its overlap.
+  const size_t num_cols = nonortho_matrices.front().n_cols;
+
+  vector<Mat<T>> augmented_matrices;
+  vector<typename Actuator<T>::BatchInquiryFn> inquiry_fns;
+  vector<std::shared_ptr<PairOrdering>> orderings;
+
+  for (size_t p = 0; p != num_problems; ++p) {
+    const auto &nonortho_matrix = nonortho_matrices[p];
+    const auto &prelim_ortho_matrix = prelim_ortho_matrices[p];
+
+    assert(
+        arma::size(nonortho_matrix) ==
+            arma::size(nonortho_matrices.front()));
+    assert(arma::size(prelim_ortho_matrix) == arma::size(nonortho_matrix));
+    assert(weights[p].size() == num_cols);
+
+    augmented_matrices.push_back(
+        augmented_ortho_matrix(nonortho_matrix, prelim_ortho_matrix));
+
+    inquiry_fns.push_back(
+        augmented_inquiry_fn<T>(weights[p], zero_abs_thresh));
+
+    orderings.push_back(default_ordering(weights[p], zero_abs_thresh));
+  }
+
+  const auto actuator = create_default_actuator<T>(
+      mpi_comm,
+      num_cols,
+      default_tuning_params(mpi_comm, GrsOneSidedRelaxParam(num_cols)),
+      max_sweeps,
+      zero_abs_thresh,
+      nullptr);
+
+  auto retval = actuator->Actuate(augmented_matrices, inquiry_fns, orderings);
+
+  // Remove the overlaps from the transformed matrices.
+  for (auto &result : retval) {
+    result.transform.shed_rows(0, num_cols - 1);
+  }
+
+  return retval;
 }
 
 } // namespace linear
@@ -1,10 +1,13 @@
 #ifndef TANUKI_PARALLEL_GRS_ACTUATOR_H
 #define TANUKI_PARALLEL_GRS_ACTUATOR_H
 
+#include <complex>
 #include <cstddef>
 #include <functional>
 #include <map>
+#include <memory>
 #include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -12,11 +15,17 @@
 #include <mpi.h>
 
 #include "tanuki/math/linear/indexed_vector_pair.h"
+#include "tanuki/math/linear/matrix_index_pair.h"
 #include "tanuki/math/linear/rotation_matrix_spec.h"
 #include "tanuki/number/types.h"
 #include "tanuki/parallel/concurrent_actuator.h"
+#include "tanuki/parallel/grs/checkpoint.h"
+#include "tanuki/parallel/grs/convergence_criterion.h"
 #include "tanuki/parallel/grs/jacobi_sidedness.h"
+#include "tanuki/parallel/grs/pair_ordering.h"
+#include "tanuki/parallel/grs/relaxation_policy.h"
 #include "tanuki/parallel/mpi/mpi_host_based_comms.h"
+#include "tanuki/parallel/mpi/mpi_persistent_allgatherv.h"
 #include "tanuki/parallel/mpi/mpi_shared_memory.h"
 
 namespace tanuki {
@@ -27,8 +36,10 @@ using arma::Col;
 using arma::Mat;
 
 using math::linear::IndexedVectorPair;
+using math::linear::MatrixIndexPair;
 using math::linear::RotationMatrixSpec;
 using parallel::mpi::MpiHostBasedComms;
+using parallel::mpi::MpiPersistentAllgatherv;
 using parallel::mpi::MpiSharedMemory;
 
 using tanuki::number::real_t;
@@ -56,6 +67,228 @@ struct Result final {
    *  @brief Whether GRS has converged.
    */
   bool has_converged;
+
+  /**
+   *  @brief Maximum magnitude of the sines of the unrelaxed rotations in the
+   *  last iteration.
+   */
+  real_t max_abs_sine;
+
+  /**
+   *  @brief Sum of the squares of the sines of the unrelaxed rotations in the
+   *  last iteration.
+   */
+  real_t sum_sq_sines;
+
+  /**
+   *  @brief Accumulated rotation, \f$ \mathbf{U} \f$, or an empty matrix if
+   *  it is not accumulated.
+   *
+   *  It is the product of all applied rotations as column rotations, so that
+   *  the transform is \f$ \mathbf{A} \mathbf{U} \f$ for a one-sided GRS
+   *  from the right, \f$ \mathbf{U}^{\mathrm{T}} \mathbf{A} \f$ for a
+   *  one-sided GRS from the left, and \f$ \mathbf{U}^{\mathrm{T}} \mathbf{A}
+   *  \mathbf{U} \f$ for a two-sided GRS, where \f$ \mathbf{A} \f$ is the
+   *  input matrix. Since the rotations are real, \f$ \mathbf{U} \f$ is
+   *  orthogonal. The same transformation can be applied to another matrix,
+   *  such as with @link math::linear::MatrixProduct @endlink, without
+   *  repeating GRS.
+   */
+  Mat<T> rotation;
+};
+
+/**
+ *  @brief Options of the GRS actuator that affect how the actuation is
+ *  performed.
+ */
+struct ActuatorOptions final {
+ public:
+  /**
+   *  @brief Whether the rotations in a group of rotation sets are applied as
+   *  a wavefront over blocks of rows (or columns for row rotations).
+   *
+   *  Since a column rotation only combines elements in the same row (and a
+   *  row rotation only those in the same column), all rotation sets in a
+   *  group are applied to a block while the block is in cache, and the
+   *  blocks are distributed across MPI processes and threads without
+   *  synchronizing between rotation sets. A single synchronization of the
+   *  threads and of the MPI processes at each host therefore suffices for
+   *  each side of a group. The result is the same as applying the rotation
+   *  sets one at a time.
+   */
+  bool is_wavefront = false;
+
+  /**
+   *  @brief Positive number of rows (or columns for row rotations) in a block
+   *  of the wavefront.
+   */
+  size_t wavefront_block_rows = 256;
+
+  /**
+   *  @brief Number of vectors in a block for level-3 block rotations, or zero
+   *  to apply rotations individually.
+   *
+   *  If positive, the vectors (columns, or rows for @link
+   *  JacobiSidedness::ONE_SIDED_LEFT @endlink) are grouped into blocks of
+   *  about this size. Rotation sets are then formed by pairing blocks in a
+   *  round-robin tournament (a block round), and by pairing the vectors in
+   *  the union of each block pair in a round-robin tournament as in
+   *  block-Jacobi methods. The rotations within each block pair are
+   *  accumulated into a small dense orthogonal matrix that is applied with a
+   *  matrix product. Each group of rotation sets consists of whole block
+   *  rounds, and @link is_wavefront @endlink is ignored.
+   */
+  size_t block_size = 0;
+
+  /**
+   *  @brief Ordering of the vector pairs into rotation sets, or null for
+   *  @link RoundRobinOrdering @endlink.
+   *
+   *  It is reset at the beginning of each actuation and updated with the
+   *  relaxed rotations after each group. It is not used for block rotations.
+   */
+  std::shared_ptr<PairOrdering> ordering;
+
+  /**
+   *  @brief Policy of the relaxation parameter, or null to use the relaxation
+   *  function of the actuator.
+   *
+   *  It is reset at the beginning of each actuation with the initial
+   *  relaxation parameter of the actuator, and it determines the relaxation
+   *  parameter after each group in place of the relaxation function.
+   */
+  std::shared_ptr<RelaxationPolicy> relaxation_policy;
+
+  /**
+   *  @brief Whether the inquiries are scheduled dynamically.
+   *
+   *  If <tt>true</tt>, each MPI process repeatedly claims chunks of rotation
+   *  pairs from a counter that is shared through MPI one-sided communication,
+   *  and the threads take the pairs of a claimed chunk with a dynamic
+   *  schedule. The relaxed rotations are then combined by a single reduction.
+   *  Otherwise, rotation pairs are divided evenly in advance, which leaves
+   *  MPI processes and threads idle if the costs of the inquiries vary.
+   */
+  bool is_dynamic_inquiry = false;
+
+  /**
+   *  @brief Positive number of rotation pairs taken by a thread at a time for
+   *  dynamic inquiries.
+   *
+   *  An MPI process claims this number times the number of threads at a
+   *  time.
+   */
+  size_t inquiry_chunk_size = 4;
+
+  /**
+   *  @brief Initial threshold of the magnitude of a relaxed rotation angle
+   *  below which the rotation is skipped, or zero to apply all rotations.
+   *
+   *  Threshold is multiplied by @link skip_threshold_decay @endlink after
+   *  each iteration. Unless GRS is two-sided, a pair whose rotation was
+   *  skipped is also not inquired again if neither of its vectors has been
+   *  rotated since then, as tracked for each vector, and its unrelaxed angle
+   *  from then is still below the threshold after relaxation. Such a pair is
+   *  inquired again once the threshold has decayed below its angle, and its
+   *  angle from then contributes to the statistics of the rotations. If the
+   *  convergence criterion is @link ConvergenceCriterion::ROTATIONS
+   *  @endlink, it cannot exceed the convergence tolerance.
+   */
+  real_t skip_threshold = 0.0;
+
+  /**
+   *  @brief Factor in the interval \f$ (0, 1] \f$ by which the threshold of
+   *  rotation angles decays after each iteration.
+   */
+  real_t skip_threshold_decay = 0.1;
+
+  /**
+   *  @brief Whether the applied rotations are accumulated into @link
+   *  Result::rotation @endlink.
+   *
+   *  Accumulation rotates the columns of a square matrix, whose order is the
+   *  number of vectors, in shared memory at each host along with the input
+   *  matrix.
+   */
+  bool is_rotation_accumulated = false;
+
+  /**
+   *  @brief Criterion of convergence.
+   *
+   *  Convergence checker of the actuator is used only for @link
+   *  ConvergenceCriterion::MATRICES @endlink.
+   */
+  ConvergenceCriterion convergence_criterion = ConvergenceCriterion::MATRICES;
+
+  /**
+   *  @brief Non-negative tolerance for @link ConvergenceCriterion::ROTATIONS
+   *  @endlink and @link ConvergenceCriterion::FROBENIUS @endlink.
+   */
+  real_t convergence_tol = 1.0e-8;
+
+  /**
+   *  @brief Positive maximum magnitude of the sines of the unrelaxed
+   *  rotations in an iteration at which a mixed-precision actuation switches
+   *  from single to double precision.
+   *
+   *  It must be well above the machine epsilon of single precision. It is
+   *  used only for the mixed-precision actuation.
+   */
+  real_t single_precision_switch_sine = 1.0e-3;
+
+  /**
+   *  @brief Path prefix of the checkpoint files, or an empty string to not
+   *  checkpoint.
+   *
+   *  At the end of every @link checkpoint_interval @endlink iterations, one
+   *  MPI process at each host copies the state of the actuation and writes
+   *  it as a @link Checkpoint @endlink in the background while the actuation
+   *  continues. File of each host is the prefix followed by a period and the
+   *  index of the host, so the prefix can be on storage that is local to the
+   *  host or shared by the hosts. If the writing of a checkpoint has failed
+   *  at any host, the actuation stops at the next checkpoint, and
+   *  <tt>std::runtime_error</tt> is thrown at every MPI process. A
+   *  checkpoint is not written for the last iteration. It is not used for
+   *  the single-precision iterations of the mixed-precision actuation.
+   */
+  std::string checkpoint_path;
+
+  /**
+   *  @brief Positive number of iterations between checkpoints.
+   */
+  size_t checkpoint_interval = 1;
+
+  /**
+   *  @brief Whether the actuation resumes from the checkpoint.
+   *
+   *  Actuation resumes only if the checkpoint file at every host can be read,
+   *  matches the size of the input matrix, and is of the same iteration as
+   *  those of the other hosts, in which case the input
+   *  matrix is replaced by the checkpointed matrix and the iterations
+   *  continue from the checkpointed iteration. Otherwise, it starts from the
+   *  input matrix. States of the ordering and of the relaxation policy are
+   *  not checkpointed and are reset.
+   */
+  bool is_checkpoint_resumed = false;
+};
+
+/**
+ *  @brief Single-precision counterpart of a type of matrix elements.
+ *
+ *  @tparam T
+ *    Type of elements in an Armadillo matrix.
+ */
+template <typename T>
+struct SinglePrecision final {
+  using type = float;
+};
+
+/**
+ *  @brief Single-precision counterpart of a complex type of matrix elements.
+ */
+template <typename T>
+struct SinglePrecision<std::complex<T>> final {
+  using type = std::complex<float>;
 };
 
 /**
@@ -80,6 +313,25 @@ class Actuator final : public ConcurrentActuator<
   using InquiryFn =
       std::function<RotationMatrixSpec(const IndexedVectorPair<T> &)>;
 
+  /**
+   *  @brief Type of the batched inquiry function.
+   *
+   *  Type of function that specifies the unrelaxed rotations for a batch of
+   *  vector pairs at once. Arguments are the type of the indices, a two-row
+   *  matrix whose columns are the index pairs with the lesser index at the
+   *  top, the matrix whose rows or columns are the vectors, and the
+   *  specifications of the rotations to fill in corresponding order to the
+   *  index pairs, respectively. Number of specifications is already the
+   *  number of index pairs. Since the pairs in a batch do not conflict, the
+   *  dot products of the vectors can be computed together with level-3
+   *  operations on the gathered vectors.
+   */
+  using BatchInquiryFn = std::function<void(
+      MatrixIndexPair::PairType,
+      const Mat<arma::uword> &,
+      const Mat<T> &,
+      std::vector<RotationMatrixSpec> &)>;
+
   /**
    *  @brief Type of the convergence checker.
    */
@@ -100,7 +352,8 @@ class Actuator final : public ConcurrentActuator<
    *    <tt>matrix</tt> must be a square matrix (otherwise
    *    <tt>std::invalid_argument</tt> is thrown), and only columns will be
    *    queried for rotations; the rotations are then applied to both rows and
-   *    columns.
+   *    columns. If a one-sided GRS from the left is to be performed, rows are
+   *    queried for and rotated instead of columns.
    *
    *  @param init_relax
    *    Initial relaxation parameter. If it is not in the range \f$ [0, 1) \f$,
@@ -124,7 +377,12 @@ class Actuator final : public ConcurrentActuator<
    *  @param convergence_checker
    *    Function that returns whether convergence is attained given the
    *    previous and current matrices, respectively, from the transformation
-   *    process.
+   *    process. It is used only if the convergence criterion in
+   *    <tt>options</tt> is @link ConvergenceCriterion::MATRICES @endlink.
+   *
+   *  @param options
+   *    Options of the actuation. If any of them is invalid,
+   *    <tt>std::domain_error</tt> is thrown.
    */
   Actuator(
       MPI_Comm mpi_comm,
@@ -134,33 +392,140 @@ class Actuator final : public ConcurrentActuator<
       size_t num_groups,
       size_t max_iterations,
       std::function<real_t(size_t, real_t, size_t)> relax_fn,
-      ConvergenceFn convergence_checker);
+      ConvergenceFn convergence_checker,
+      const ActuatorOptions &options = ActuatorOptions());
 
   /**
    *  @brief Actuates GRS.
    *
    *  The rotation returned from the inquiry function is not relaxed.
-   *  Relaxation is performed by the actuator. Matrix index pair is always
-   *  @link MatrixIndexPair::PairType::COLUMNS @endlink.
+   *  Relaxation is performed by the actuator. Matrix index pair is @link
+   *  MatrixIndexPair::PairType::ROWS @endlink for @link
+   *  JacobiSidedness::ONE_SIDED_LEFT @endlink and @link
+   *  MatrixIndexPair::PairType::COLUMNS @endlink otherwise.
+   *
+   *  Iterations are performed by one team of threads for the whole
+   *  actuation, and MPI is invoked only by the master thread of the team.
+   *  Once the inquiries of a group are complete, the exchanges of the relaxed
+   *  rotations of its rotation sets (or of the whole group for wavefronts and
+   *  block rotations) are started as nonblocking collectives, and each is
+   *  waited for just before its rotation set is applied, so that the
+   *  exchange of a rotation set overlaps with the application of the
+   *  previous ones.
    *
    *  All MPI processes must invoke this outside any OpenMP parallel region.
    */
   Result<T> Actuate(const Mat<T> &input, InquiryFn inquiry_fn) override;
 
+  /**
+   *  @brief Actuates GRS through a batched inquiry function.
+   *
+   *  Rotation pairs of each group that are assigned to an MPI process are
+   *  divided into batches by the threads (or by the chunks for dynamic
+   *  inquiries), and the batched inquiry function is invoked once for each
+   *  batch. It is invoked concurrently from multiple threads but is never
+   *  given a dummy pair or a pair whose inquiry is skipped. Otherwise, it is
+   *  the same as the actuation through an inquiry function for each pair.
+   */
+  Result<T> Actuate(const Mat<T> &input, BatchInquiryFn batch_inquiry_fn);
+
+  /**
+   *  @brief Actuates GRS in mixed precision through batched inquiry
+   *  functions.
+   *
+   *  Initial iterations are performed on a single-precision copy of the input
+   *  matrix, which halves the memory traffic of the rotations, until the
+   *  maximum magnitude of the sines of the unrelaxed rotations in an
+   *  iteration does not exceed @link
+   *  ActuatorOptions::single_precision_switch_sine @endlink. Accumulated
+   *  rotation of the single-precision iterations is then replaced by the
+   *  nearest orthogonal matrix in double precision and applied to the input
+   *  matrix, from which the iterations continue in double precision with the
+   *  convergence criterion of the actuator. The two phases use the same
+   *  parameters and options otherwise, and each is limited to the maximum
+   *  number of iterations.
+   *
+   *  @param single_batch_inquiry_fn
+   *    Batched inquiry function for the single-precision iterations. It is
+   *    usually the same function as <tt>batch_inquiry_fn</tt> instantiated
+   *    for the single-precision type.
+   */
+  Result<T> Actuate(
+      const Mat<T> &input,
+      BatchInquiryFn batch_inquiry_fn,
+      typename Actuator<typename SinglePrecision<T>::type>::BatchInquiryFn
+          single_batch_inquiry_fn);
+
+  /**
+   *  @brief Actuates GRS on several independent problems together.
+   *
+   *  Input matrices are concatenated by columns, and the rotation sets of the
+   *  problems are interleaved by @link MultiProblemOrdering @endlink, so
+   *  that the problems share the shared memory, the rotation sets, and the
+   *  gathering of the rotations of each group. Each batched inquiry function
+   *  is given the columns of its own input matrix with indices local to the
+   *  problem. Pairs of columns of different problems, which are formed only
+   *  by block rotations, are not inquired and are not rotated. Convergence is
+   *  checked on the concatenated matrices, so that the problems share the
+   *  number of iterations and the rotation statistics of the results.
+   *
+   *  All MPI processes must invoke this outside any OpenMP parallel region.
+   *
+   *  @param inputs
+   *    Input matrices with the same number of rows. If GRS is not one-sided
+   *    from the right, <tt>std::invalid_argument</tt> is thrown.
+   *
+   *  @param batch_inquiry_fns
+   *    Batched inquiry function of each problem.
+   *
+   *  @param orderings
+   *    Ordering of the column pairs of each problem, or null for @link
+   *    RoundRobinOrdering @endlink. If empty, every problem is ordered by
+   *    @link RoundRobinOrdering @endlink. Ordering in the options is not used.
+   *
+   *  @return
+   *    Result of each problem.
+   */
+  std::vector<Result<T>> Actuate(
+      const std::vector<Mat<T>> &inputs,
+      const std::vector<BatchInquiryFn> &batch_inquiry_fns,
+      const std::vector<std::shared_ptr<PairOrdering>> &orderings =
+          std::vector<std::shared_ptr<PairOrdering>>());
+
   MPI_Comm mpi_comm() const override;
 
   size_t max_threads() const override;
 
  private:
+  /**
+   *  @brief Actuates GRS through a batched inquiry function with a given
+   *  ordering of the vector pairs.
+   *
+   *  @param pair_ordering
+   *    Ordering of the vector pairs, or null for @link RoundRobinOrdering
+   *    @endlink.
+   */
+  Result<T> ActuateOrdered(
+      const Mat<T> &input,
+      BatchInquiryFn batch_inquiry_fn,
+      std::shared_ptr<PairOrdering> pair_ordering);
+
+  /**
+   *  @brief Waits for the threads of the team of the actuation and for the
+   *  MPI processes at this host.
+   *
+   *  It must be invoked by all threads of the team. MPI is invoked by the
+   *  master thread.
+   */
+  void IntrahostBarrier() const;
+
   /**
    *  @brief Applies the rotations in a rotation set by distributing them
    *  across MPI processes and threads.
    *
-   *  It must be invoked by all MPI processes outside of any OpenMP parallel
-   *  region.
-   *
-   *  @param use_mpi
-   *    Whether to parallelize the rotation applications across MPI processes.
+   *  It must be invoked by all threads of the team of the actuation at all
+   *  MPI processes, and it ends with a barrier of the team and of the MPI
+   *  processes at this host.
    *
    *  @param rotation_set
    *    Two-row matrix of a rotation set, as column indices, that contains
@@ -171,21 +536,178 @@ class Actuator final : public ConcurrentActuator<
    *    indices in a non-conflicting manner or any of the indices are
    *    out-of-range with respect to <tt>matrix</tt>.
    *
-   *  @param rotation_specs
-   *    Rotation specifications. Number of elements must be the same as the
-   *    number of columns in <tt>rotation_set</tt>. The element that
-   *    corresponds to the dummy pair (if there is one) is ignored.
+   *  @param cosine_sine
+   *    Cosines and sines of the rotations at the top and bottom rows,
+   *    respectively, corresponding by column to <tt>rotation_set</tt>. The
+   *    column that corresponds to the dummy pair (if there is one) is
+   *    ignored.
    *
    *  @param is_by_col
    *    Whether the rotations are applied to the columns (<tt>true</tt>) or
-   *    rows (<tt>false</tt>).
+   *    rows (<tt>false</tt>). Rows are rotated in place with a stride over
+   *    the columns that are distributed across MPI processes and threads.
    *
    *  @param matrix
    *    Output matrix whose columns or rows are concurrently rotated.
    */
   void DistApplyRotationSet(
       const arma::Mat<long long> &rotation_set,
-      const std::vector<RotationMatrixSpec> &rotation_specs,
+      const arma::Mat<real_t> &cosine_sine,
+      bool is_by_col,
+      arma::Mat<T> &matrix) const;
+
+  /**
+   *  @brief Checks for convergence by the Frobenius norm of the change of the
+   *  matrix relative to that of the current matrix, with the columns
+   *  distributed across the MPI processes and threads at each host.
+   *
+   *  It must be invoked by all threads of the team of the actuation at all
+   *  MPI processes, and it ends with a barrier of the team and of the MPI
+   *  processes at this host.
+   *
+   *  @param curr_matrix
+   *    Current matrix.
+   *
+   *  @param prev_matrix
+   *    Previous matrix, which is overwritten by the current matrix.
+   *
+   *  @param sq_norms
+   *    Storage, shared by the team, of the squared Frobenius norms of the
+   *    change and of the current matrix.
+   *
+   *  @return
+   *    Whether the relative change does not exceed the tolerance.
+   */
+  bool DistFrobeniusConverged(
+      const arma::Mat<T> &curr_matrix,
+      arma::Mat<T> &prev_matrix,
+      real_t (&sq_norms)[2]) const;
+
+  /**
+   *  @brief Pair of blocks of vectors in a block round.
+   */
+  struct BlockPair final {
+   public:
+    /**
+     *  @brief Index of the first vector in the first block.
+     */
+    size_t first_begin;
+
+    /**
+     *  @brief Past-the-end index of the vectors in the first block.
+     */
+    size_t first_end;
+
+    /**
+     *  @brief Index of the first vector in the second block.
+     */
+    size_t second_begin;
+
+    /**
+     *  @brief Past-the-end index of the vectors in the second block.
+     */
+    size_t second_end;
+
+    /**
+     *  @brief Index of the first rotation pair of the block pair in the
+     *  rotation pairs of the group.
+     */
+    size_t rp_begin;
+
+    /**
+     *  @brief Past-the-end index of the rotation pairs of the block pair in
+     *  the rotation pairs of the group.
+     */
+    size_t rp_end;
+  };
+
+  /**
+   *  @brief Appends the rotation pairs of a block round to the rotation pairs
+   *  of a group.
+   *
+   *  @param block_round
+   *    Round of the round-robin tournament of blocks, where each row is a
+   *    pair of block indices.
+   *
+   *  @param block_bounds
+   *    Delimitation of vectors by block.
+   *
+   *  @param rotation_pairs
+   *    Two-row matrix of rotation pairs of the group to append to. Rotation
+   *    pairs of each block pair are contiguous and in the order of
+   *    application.
+   *
+   *  @param block_rounds
+   *    Block pairs of each block round of the group to append to.
+   */
+  static void AppendBlockRound(
+      const arma::Mat<long long> &block_round,
+      const std::vector<size_t> &block_bounds,
+      arma::Mat<long long> &rotation_pairs,
+      std::vector<std::vector<BlockPair>> &block_rounds);
+
+  /**
+   *  @brief Applies the rotations of a block round by accumulating them
+   *  within each block pair and distributing the block pairs across MPI
+   *  processes and threads.
+   *
+   *  It must be invoked by all threads of the team of the actuation at all
+   *  MPI processes, and it ends with a barrier of the team and of the MPI
+   *  processes at this host.
+   *
+   *  @param block_pairs
+   *    Non-conflicting block pairs of the block round.
+   *
+   *  @param rotation_pairs
+   *    Two-row matrix of rotation pairs of the group.
+   *
+   *  @param cosine_sine
+   *    Cosines and sines of the rotations at the top and bottom rows,
+   *    respectively, corresponding by column to <tt>rotation_pairs</tt>.
+   *
+   *  @param is_by_col
+   *    Whether the rotations are applied to the columns (<tt>true</tt>) or
+   *    rows (<tt>false</tt>).
+   *
+   *  @param matrix
+   *    Output matrix whose columns or rows are rotated.
+   */
+  void DistApplyBlockRotations(
+      const std::vector<BlockPair> &block_pairs,
+      const arma::Mat<long long> &rotation_pairs,
+      const arma::Mat<real_t> &cosine_sine,
+      bool is_by_col,
+      arma::Mat<T> &matrix) const;
+
+  /**
+   *  @brief Applies the rotations in a group of rotation sets as a wavefront
+   *  over blocks of elements of the vectors that are distributed across MPI
+   *  processes and threads.
+   *
+   *  It must be invoked by all threads of the team of the actuation at all
+   *  MPI processes, and it ends with a barrier of the team and of the MPI
+   *  processes at this host.
+   *
+   *  @param rotation_pairs
+   *    Two-row matrix of the concatenated rotation sets in the group, in the
+   *    order of application. See @link DistApplyRotationSet @endlink for the
+   *    requirements of each rotation set.
+   *
+   *  @param cosine_sine
+   *    Cosines and sines of the rotations at the top and bottom rows,
+   *    respectively, corresponding by column to <tt>rotation_pairs</tt>.
+   *
+   *  @param is_by_col
+   *    Whether the rotations are applied to the columns (<tt>true</tt>) over
+   *    blocks of rows, or to the rows (<tt>false</tt>) over blocks of
+   *    columns.
+   *
+   *  @param matrix
+   *    Output matrix whose columns or rows are rotated.
+   */
+  void DistApplyRotationGroup(
+      const arma::Mat<long long> &rotation_pairs,
+      const arma::Mat<real_t> &cosine_sine,
       bool is_by_col,
       arma::Mat<T> &matrix) const;
 
@@ -201,6 +723,12 @@ class Actuator final : public ConcurrentActuator<
   const std::string shared_mem_curr_mat_name_ =
       std::string("parallel_grs_actuator_curr_matrix");
 
+  /**
+   *  @brief Name of the shared memory for the accumulated rotation.
+   */
+  const std::string shared_mem_rotation_name_ =
+      std::string("parallel_grs_actuator_rotation");
+
   /**
    *  @brief MPI communicator of the processes across hosts.
    */
@@ -221,6 +749,18 @@ class Actuator final : public ConcurrentActuator<
    */
   MpiHostBasedComms host_based_comms_;
 
+  /**
+   *  @brief Rank of this MPI process in the intrahost communicator of @link
+   *  host_based_comms_ @endlink.
+   */
+  int intrahost_rank_;
+
+  /**
+   *  @brief Number of MPI processes in the intrahost communicator of @link
+   *  host_based_comms_ @endlink.
+   */
+  int intrahost_size_;
+
   /**
    *  @brief Maximum number of threads to use.
    */
@@ -258,6 +798,11 @@ class Actuator final : public ConcurrentActuator<
    *  @brief Convergence checker.
    */
   const ConvergenceFn convergence_checker_;
+
+  /**
+   *  @brief Options of the actuation.
+   */
+  const ActuatorOptions options_;
 };
 
 /**
@@ -7,7 +7,11 @@
 #include <complex>
 #include <cstdlib>
 #include <cstring>
+#include <exception>
+#include <future>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <stdexcept>
 #include <string>
 
@@ -34,7 +38,6 @@ using std::strcpy;
 using std::string;
 using std::vector;
 
-using arma::uvec;
 using boost::interprocess::mapped_region;
 using boost::interprocess::open_only;
 using boost::interprocess::open_or_create;
@@ -45,10 +48,62 @@ using common::divider::GroupConsecutive;
 using common::divider::GroupIndices;
 using common::divider::GroupSizes;
 using math::combinatorics::RoundRobinTourney;
-using math::linear::CreateGivensRotation;
+using math::linear::ApplyGivensRotation;
+using math::linear::CreateIdentityRotation;
+using math::linear::IsIdentityRotation;
 using math::linear::MatrixIndexPair;
 using math::linear::RotationMatrixSpec;
 
+using tanuki::number::complex_t;
+
+namespace {
+
+  /**
+   *  @brief Product of a real matrix and a real orthogonal matrix.
+   */
+  template <typename P>
+  inline Mat<P> multiply_real_right(const Mat<P> &a, const Mat<P> &b) {
+    return a * b;
+  }
+
+  /**
+   *  @brief Product of a complex matrix and a real orthogonal matrix.
+   *
+   *  Real and imaginary parts are multiplied separately as planar real
+   *  matrices, which avoids the mixed-type product.
+   */
+  template <typename P>
+  inline Mat<std::complex<P>> multiply_real_right(
+      const Mat<std::complex<P>> &a, const Mat<P> &b) {
+    return Mat<std::complex<P>>(
+        Mat<P>(arma::real(a)) * b,
+        Mat<P>(arma::imag(a)) * b);
+  }
+
+  /**
+   *  @brief Product of a real orthogonal matrix and a real matrix.
+   */
+  template <typename P>
+  inline Mat<P> multiply_real_left(const Mat<P> &a, const Mat<P> &b) {
+    return a * b;
+  }
+
+  /**
+   *  @brief Product of a real orthogonal matrix and a complex matrix.
+   *
+   *  Real and imaginary parts are multiplied separately as planar real
+   *  matrices, which avoids the mixed-type product.
+   */
+  template <typename P>
+  inline Mat<std::complex<P>> multiply_real_left(
+      const Mat<P> &a, const Mat<std::complex<P>> &b) {
+    return Mat<std::complex<P>>(
+        a * Mat<P>(arma::real(b)),
+        a * Mat<P>(arma::imag(b)));
+  }
+
+}
+
 template <typename T>
 Actuator<T>::Actuator(
     MPI_Comm mpi_comm,
@@ -58,7 +113,8 @@ Actuator<T>::Actuator(
     size_t num_groups,
     size_t max_iterations,
     std::function<real_t(size_t, real_t, size_t)> relax_fn,
-    ConvergenceFn convergence_checker)
+    ConvergenceFn convergence_checker,
+    const ActuatorOptions &options)
         : mpi_comm_(mpi_comm),
           max_threads_(max_threads),
           sidedness_(sidedness),
@@ -67,6 +123,7 @@ Actuator<T>::Actuator(
           max_iterations_(max_iterations),
           relax_fn_(relax_fn),
           convergence_checker_(convergence_checker),
+          options_(options),
           host_based_comms_(MpiHostBasedComms(mpi_comm)) {
   int thread_support;
   MPI_Query_thread(&thread_support);
@@ -87,9 +144,50 @@ Actuator<T>::Actuator(
     throw std::domain_error("Maximum number of iterations is not positive.");
   }
 
+  if (options_.inquiry_chunk_size == 0) {
+    throw std::domain_error("Number of rotation pairs in a chunk is zero.");
+  }
+
+  if (options_.skip_threshold < 0.0) {
+    throw std::domain_error("Threshold of rotation angles is negative.");
+  }
+
+  if (options_.skip_threshold_decay <= 0.0 ||
+      options_.skip_threshold_decay > 1.0) {
+    throw std::domain_error(
+        "Decay factor of the threshold is not in the interval (0, 1].");
+  }
+
+  if (options_.convergence_tol < 0.0) {
+    throw std::domain_error("Convergence tolerance is negative.");
+  }
+
+  if (options_.convergence_criterion == ConvergenceCriterion::ROTATIONS &&
+      options_.skip_threshold > options_.convergence_tol) {
+    throw std::domain_error(
+        "Threshold of rotation angles exceeds the convergence tolerance.");
+  }
+
+  if (options_.single_precision_switch_sine <= 0.0) {
+    throw std::domain_error(
+        "Maximum sine to switch to double precision is not positive.");
+  }
+
+  if (options_.checkpoint_interval == 0) {
+    throw std::domain_error(
+        "Number of iterations between checkpoints is zero.");
+  }
+
+  if (options_.wavefront_block_rows == 0) {
+    throw std::domain_error("Number of rows in a wavefront block is zero.");
+  }
+
   MPI_Comm_rank(mpi_comm_, &mpi_rank_);
   MPI_Comm_size(mpi_comm_, &mpi_comm_size_);
 
+  MPI_Comm_rank(host_based_comms_.intrahost(), &intrahost_rank_);
+  MPI_Comm_size(host_based_comms_.intrahost(), &intrahost_size_);
+
   const auto &hosts = host_based_comms_.hosts();
 
   {
@@ -105,9 +203,74 @@ Actuator<T>::Actuator(
 
 template <typename T>
 Result<T> Actuator<T>::Actuate(const Mat<T> &input, InquiryFn inquiry_fn) {
+  // Batched inquiry function that inquires the vector pairs one at a time.
+  BatchInquiryFn batch_inquiry_fn = [&inquiry_fn](
+      MatrixIndexPair::PairType pair_type,
+      const Mat<arma::uword> &index_pairs,
+      const Mat<T> &matrix,
+      vector<RotationMatrixSpec> &rotation_specs) -> void {
+    for (size_t p = 0; p != index_pairs.n_cols; ++p) {
+      const MatrixIndexPair indices = {
+        .type = pair_type,
+        .first = index_pairs(0, p),
+        .second = index_pairs(1, p)
+      };
+
+      if (pair_type == MatrixIndexPair::PairType::ROWS) {
+        // Rows are not contiguous and are copied as columns.
+        const Col<T> first_row(matrix.row(indices.first).st());
+        const Col<T> second_row(matrix.row(indices.second).st());
+
+        const IndexedVectorPair<T> vectors = {
+          .indices = indices,
+          .first = first_row,
+          .second = second_row
+        };
+
+        rotation_specs[p] = inquiry_fn(vectors);
+      } else {
+        const IndexedVectorPair<T> vectors = {
+          .indices = indices,
+          .first = Col<T>(
+              const_cast<T *>(matrix.colptr(indices.first)),
+              matrix.n_rows,
+              false,
+              true),
+          .second = Col<T>(
+              const_cast<T *>(matrix.colptr(indices.second)),
+              matrix.n_rows,
+              false,
+              true)
+        };
+
+        rotation_specs[p] = inquiry_fn(vectors);
+      }
+    }
+  };
+
+  return Actuate(input, batch_inquiry_fn);
+}
+
+template <typename T>
+Result<T> Actuator<T>::Actuate(
+    const Mat<T> &input, BatchInquiryFn batch_inquiry_fn) {
+  return ActuateOrdered(input, batch_inquiry_fn, options_.ordering);
+}
+
+template <typename T>
+Result<T> Actuator<T>::ActuateOrdered(
+    const Mat<T> &input,
+    BatchInquiryFn batch_inquiry_fn,
+    std::shared_ptr<PairOrdering> pair_ordering) {
   assert(!omp_in_parallel());
 
-  if (input.n_rows == 0 || input.n_cols < 2) {
+  // Whether rows instead of columns are queried for rotations.
+  const bool is_by_row = sidedness_ == JacobiSidedness::ONE_SIDED_LEFT;
+
+  // Number of vectors that are queried for rotations.
+  const size_t num_vectors = is_by_row ? input.n_rows : input.n_cols;
+
+  if (input.n_elem == 0 || num_vectors < 2) {
     throw std::length_error("Invalid size of the input matrix to transform.");
   }
 
@@ -116,32 +279,71 @@ Result<T> Actuator<T>::Actuate(const Mat<T> &input, InquiryFn inquiry_fn) {
         "GRS is two-sided but the input matrix is not square.");
   }
 
-  // Column indices as competitors in a round-robin tournament, where each
-  // round is a non-conflicting rotation set.
-  RoundRobinTourney<long long> tourney(input.n_cols);
+  // Whether rotations are accumulated and applied by blocks.
+  const bool is_block = options_.block_size != 0;
+
+  // Delimitation of vectors by block for block rotations.
+  const auto block_bounds = is_block ?
+      GroupIndices(
+          0, num_vectors,
+          std::max<size_t>(
+              2, (num_vectors + options_.block_size - 1) /
+                  options_.block_size)) :
+      vector<size_t>();
+
+  // Column (or row) indices as competitors in a round-robin tournament, where
+  // each round is a non-conflicting rotation set. For block rotations, block
+  // indices are the competitors instead, and each round is a block round.
+  RoundRobinTourney<long long> tourney(
+      is_block ? block_bounds.size() - 1 : num_vectors);
+
+  // Ordering of the vector pairs into rotation sets, which is not used for
+  // block rotations.
+  const std::shared_ptr<PairOrdering> ordering = pair_ordering ?
+      pair_ordering :
+      std::shared_ptr<PairOrdering>(new RoundRobinOrdering());
+
+  if (!is_block) {
+    ordering->Reset(num_vectors);
+  }
 
   // Number of rotation sets for each group.
-  const auto group_sizes = GroupSizes(0, tourney.num_rounds(), num_groups_);
+  const auto group_sizes = GroupSizes(
+      0,
+      is_block ? tourney.num_rounds() : ordering->num_rotation_sets(),
+      num_groups_);
 
-  // Shared memory for the previous matrix.
-  MpiSharedMemory prev_mat_shm(
-      mpi_comm_, shared_mem_prev_mat_name_,
-      sizeof(T) * input.n_elem, open_or_create);
+  const auto criterion = options_.convergence_criterion;
 
-  // Pointer to the shared memory for the previous matrix in the iteration.
-  const auto prev_mat_shm_ptr = static_cast<T *>(prev_mat_shm.mem_address());
-
-  parallel::memory::Copy(
-      host_based_comms_.intrahost(),
-      input.memptr(),
-      prev_mat_shm_ptr,
-      sizeof(T) * input.n_elem);
+  // Shared memory for the previous matrix, which is not kept if convergence
+  // is checked from the rotations.
+  std::unique_ptr<MpiSharedMemory> prev_mat_shm;
 
   // Matrix from the previous iteration to check for convergence.
-  Mat<T> prev_matrix(
-      prev_mat_shm_ptr,
-      input.n_rows, input.n_cols,
-      false, true);
+  std::unique_ptr<Mat<T>> prev_matrix;
+
+  if (criterion != ConvergenceCriterion::ROTATIONS) {
+    prev_mat_shm.reset(
+        new MpiSharedMemory(
+            mpi_comm_, shared_mem_prev_mat_name_,
+            sizeof(T) * input.n_elem, open_or_create));
+
+    // Pointer to the shared memory for the previous matrix in the iteration.
+    const auto prev_mat_shm_ptr =
+        static_cast<T *>(prev_mat_shm->mem_address());
+
+    parallel::memory::Copy(
+        host_based_comms_.intrahost(),
+        input.memptr(),
+        prev_mat_shm_ptr,
+        sizeof(T) * input.n_elem);
+
+    prev_matrix.reset(
+        new Mat<T>(
+            prev_mat_shm_ptr,
+            input.n_rows, input.n_cols,
+            false, true));
+  }
 
   // Shared memory for the current matrix.
   MpiSharedMemory curr_mat_shm(
@@ -163,175 +365,1158 @@ Result<T> Actuator<T>::Actuate(const Mat<T> &input, InquiryFn inquiry_fn) {
       input.n_rows, input.n_cols,
       false, true);
 
+  // Shared memory for the accumulated rotation.
+  std::unique_ptr<MpiSharedMemory> rotation_shm;
+
+  // Accumulated rotation whose columns are rotated by all rotations.
+  std::unique_ptr<Mat<T>> rotation;
+
+  if (options_.is_rotation_accumulated) {
+    rotation_shm.reset(
+        new MpiSharedMemory(
+            mpi_comm_, shared_mem_rotation_name_,
+            sizeof(T) * num_vectors * num_vectors, open_or_create));
+
+    const auto rotation_shm_ptr = static_cast<T *>(rotation_shm->mem_address());
+
+    const Mat<T> identity(num_vectors, num_vectors, arma::fill::eye);
+
+    parallel::memory::Copy(
+        host_based_comms_.intrahost(),
+        identity.memptr(),
+        rotation_shm_ptr,
+        sizeof(T) * identity.n_elem);
+
+    rotation.reset(
+        new Mat<T>(
+            rotation_shm_ptr,
+            num_vectors, num_vectors,
+            false, true));
+  }
+
   real_t relaxation = init_relax_;
 
+  // Policy of the relaxation parameter, or null to use the relaxation
+  // function.
+  const auto &relaxation_policy = options_.relaxation_policy;
+
+  if (relaxation_policy) {
+    relaxation_policy->Reset(num_groups_, init_relax_);
+  }
+
+  // Whether rotations with negligible angles are skipped.
+  const bool is_threshold = options_.skip_threshold > 0.0;
+
+  // Whether inquiries of pairs whose vectors have not been rotated since
+  // their last negligible rotations are skipped. It is valid only if a
+  // rotation modifies no vectors other than those of its pair.
+  const bool is_inquiry_skippable =
+      is_threshold && sidedness_ != JacobiSidedness::TWO_SIDED &&
+      (is_block || ordering->is_static());
+
+  // Threshold of the magnitude of a relaxed rotation angle.
+  real_t threshold = options_.skip_threshold;
+
   Result<T> retval;
+  retval.num_iters = 0;
   retval.has_converged = false;
+  retval.max_abs_sine = 0.0;
+  retval.sum_sq_sines = 0.0;
+
+  int intrahost_rank;
+  MPI_Comm_rank(host_based_comms_.intrahost(), &intrahost_rank);
+
+  // Whether this MPI process writes the checkpoints of its host.
+  const bool is_checkpoint_writer =
+      !options_.checkpoint_path.empty() && intrahost_rank == 0;
 
-  for (size_t iter = 0; iter != max_iterations_; ++iter) {
-    // Iterator to a rotation set.
-    auto rs_it = tourney.begin();
+  // Path to the checkpoint file of this host, which is distinct across the
+  // hosts in case the path is on a shared file system.
+  std::string checkpoint_path;
 
-    // Iterate over groups of rotation sets.
-    for (size_t gr = 0; gr != num_groups_; ++gr) {
-      // Rotation pairs, corresponding by column, in the group.
-      Mat<long long> rotation_pairs;
+  if (is_checkpoint_writer) {
+    int interhost_rank;
+    MPI_Comm_rank(host_based_comms_.interhost(), &interhost_rank);
 
-      // Concatenate rotation sets in the group.
-      for (size_t rs = 0; rs != group_sizes[gr]; ++rs) {
-        rotation_pairs = arma::join_horiz(rotation_pairs, rs_it->t());
-        ++rs_it;
+    checkpoint_path =
+        options_.checkpoint_path + "." + std::to_string(interhost_rank);
+  }
+
+  // Writing of the most recent checkpoint in the background.
+  std::future<void> checkpoint_writing;
+
+  // Waits for the writing of the most recent checkpoint, if any, and returns
+  // whether it has succeeded at every host. All MPI processes must invoke
+  // this.
+  auto is_checkpoint_written = [&]() -> bool {
+    int is_written = 1;
+
+    if (checkpoint_writing.valid()) {
+      try {
+        checkpoint_writing.get();
+      } catch (const std::exception &) {
+        is_written = 0;
       }
+    }
 
-      // Matrix of relaxed rotation cosines and sines at the top and bottom
-      // rows, respectively, for rotation pairs.
-      Mat<real_t> cosine_sine(2, rotation_pairs.n_cols);
+    MPI_Allreduce(
+        MPI_IN_PLACE, &is_written, 1, MPI_INT, MPI_LAND, mpi_comm_);
+
+    return is_written;
+  };
+
+  // Whether the writing of a checkpoint has failed at any host.
+  bool has_checkpoint_failed = false;
+
+  if (!options_.checkpoint_path.empty() && options_.is_checkpoint_resumed) {
+    Checkpoint<T> checkpoint;
+
+    // Whether the checkpoint at every host can be resumed from.
+    int is_resumable = 1;
+
+    if (is_checkpoint_writer) {
+      try {
+        is_resumable =
+            ReadCheckpoint(checkpoint_path, checkpoint) &&
+            arma::size(checkpoint.matrix) == arma::size(input) &&
+            (rotation ?
+                 arma::size(checkpoint.rotation) == arma::size(*rotation) :
+                 true);
+      } catch (const std::exception &) {
+        is_resumable = 0;
+      }
+    }
+
+    MPI_Allreduce(
+        MPI_IN_PLACE, &is_resumable, 1, MPI_INT, MPI_LAND, mpi_comm_);
 
-      // Delimitation of rotation pairs by MPI processes.
-      const auto batch_indices = GroupIndices(
-          0, rotation_pairs.n_cols, mpi_comm_size_);
+    // Checkpoints of the hosts must be of the same iteration, which is not
+    // the case if a host was interrupted while writing.
+    if (is_resumable) {
+      unsigned long long min_num_iters =
+          std::numeric_limits<unsigned long long>::max();
+
+      unsigned long long max_num_iters = 0;
+
+      if (is_checkpoint_writer) {
+        min_num_iters = checkpoint.num_iters;
+        max_num_iters = checkpoint.num_iters;
+      }
 
-      // Delimitation of rotation pairs by threads.
-      const auto chunk_indices = GroupIndices(
-          batch_indices[mpi_rank_],
-          batch_indices[mpi_rank_ + 1],
-          max_threads());
+      MPI_Allreduce(
+          MPI_IN_PLACE, &min_num_iters, 1, MPI_UNSIGNED_LONG_LONG, MPI_MIN,
+          mpi_comm_);
 
-      #pragma omp parallel default(shared)
+      MPI_Allreduce(
+          MPI_IN_PLACE, &max_num_iters, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX,
+          mpi_comm_);
+
+      is_resumable = min_num_iters == max_num_iters;
+    }
+
+    if (is_resumable) {
+      // Scalars of the checkpoint, which are the same at every writer and
+      // the lowest value elsewhere.
+      real_t scalars[5];
+      std::fill(
+          std::begin(scalars), std::end(scalars),
+          std::numeric_limits<real_t>::lowest());
+
+      if (is_checkpoint_writer) {
+        std::copy(
+            checkpoint.matrix.begin(), checkpoint.matrix.end(),
+            curr_matrix.begin());
+
+        if (prev_matrix) {
+          std::copy(
+              checkpoint.matrix.begin(), checkpoint.matrix.end(),
+              prev_matrix->begin());
+        }
+
+        if (rotation) {
+          std::copy(
+              checkpoint.rotation.begin(), checkpoint.rotation.end(),
+              rotation->begin());
+        }
+
+        scalars[0] = checkpoint.num_iters;
+        scalars[1] = checkpoint.relaxation;
+        scalars[2] = checkpoint.skip_threshold;
+        scalars[3] = checkpoint.max_abs_sine;
+        scalars[4] = checkpoint.sum_sq_sines;
+      }
+
+      MPI_Allreduce(
+          MPI_IN_PLACE, scalars, 5, MPI_DOUBLE, MPI_MAX, mpi_comm_);
+
+      retval.num_iters = static_cast<size_t>(scalars[0]);
+      relaxation = scalars[1];
+      threshold = scalars[2];
+      retval.max_abs_sine = scalars[3];
+      retval.sum_sq_sines = scalars[4];
+
+      // Ensure the resumed matrices are visible at each host.
+      MPI_Barrier(host_based_comms_.intrahost());
+    }
+  }
+
+  // One more than the index of the group, counted from the beginning of the
+  // actuation, in which each vector was last rotated, or zero if it has not
+  // been rotated.
+  vector<size_t> rotated_stamps(num_vectors, 0);
+
+  // Unrelaxed angle of the rotation at each position of the rotation pairs
+  // in an iteration when it was last inquired by this MPI process and
+  // skipped.
+  vector<real_t> skipped_angles;
+
+  // One more than the index of the group, counted from the beginning of the
+  // actuation, in which the angle at each position was stored in
+  // skipped_angles, or zero if it has not been stored.
+  vector<size_t> skipped_stamps;
+
+  // Window of the counter of claimed rotation pairs at the MPI process of
+  // rank 0 for dynamic inquiries.
+  MPI_Win counter_win = MPI_WIN_NULL;
+
+  // Value of the counter at the beginning of the current group.
+  unsigned long long counter_base = 0;
+
+  if (options_.is_dynamic_inquiry) {
+    unsigned long long *counter_ptr;
+
+    MPI_Win_allocate(
+        mpi_rank_ == 0 ? sizeof(unsigned long long) : 0,
+        sizeof(unsigned long long), MPI_INFO_NULL, mpi_comm_,
+        &counter_ptr, &counter_win);
+
+    if (mpi_rank_ == 0) {
+      *counter_ptr = 0;
+    }
+
+    MPI_Barrier(mpi_comm_);
+    MPI_Win_lock_all(0, counter_win);
+  }
+
+  // Relaxed rotations of each group, whose shape is the same across
+  // iterations.
+  vector<Mat<real_t>> group_cosine_sines(num_groups_);
+
+  // Gatherings of the relaxed rotations of each stage of each group by the
+  // MPI processes for static inquiries.
+  vector<vector<std::unique_ptr<MpiPersistentAllgatherv>>> group_gathers(
+      num_groups_);
+
+  // Delimitation of the rotation pairs of each group by stage for which the
+  // gatherings of the group were set up.
+  vector<vector<size_t>> group_stage_bounds(num_groups_);
+
+  // Requests of the reductions of the relaxed rotations of each stage of a
+  // group for dynamic inquiries.
+  vector<MPI_Request> stage_reductions;
+
+  // Whether the rotations of a group are exchanged and applied by rotation
+  // set, so that the exchange of the next rotation set overlaps with the
+  // application of the current one. Wavefronts and block rotations apply the
+  // whole group at once and are a single stage.
+  const bool is_staged_by_set = !is_block && !options_.is_wavefront;
+
+  // Iteration from which the actuation starts.
+  const size_t first_iter = retval.num_iters;
+
+  // Iterator to a rotation set.
+  auto rs_it = tourney.begin();
+
+  // Rotation pairs, corresponding by column, in the current group.
+  Mat<long long> rotation_pairs;
+
+  // Block pairs of each block round in the current group for block
+  // rotations.
+  vector<vector<BlockPair>> block_rounds;
+
+  // Delimitation of the rotation pairs of the current group by stage of
+  // exchange and application.
+  vector<size_t> stage_bounds;
+
+  // Maximum magnitude and sum of squares of the sines of the unrelaxed
+  // rotations computed by this MPI process in the current iteration.
+  real_t max_abs_sine = 0.0;
+  real_t sum_sq_sines = 0.0;
+
+  // Rotation pairs of the current claim for dynamic inquiries, and whether
+  // the claim has any.
+  size_t claim_first = 0;
+  size_t claim_last = 0;
+  bool is_claimed = false;
+
+  // Squared Frobenius norms of the change and of the current matrix.
+  real_t frobenius_sq_norms[2];
+
+  // Whether the actuation stops at the end of the current group, and the
+  // exception, if any, that stopped it.
+  bool is_stopped = false;
+  std::exception_ptr stop_exception;
+
+  // Iterations are performed by one team of threads for the whole actuation.
+  // MPI is invoked by the master thread between barriers of the team.
+  #pragma omp parallel default(shared) num_threads(max_threads())
+  {
+    const size_t thread_num = omp_get_thread_num();
+    const size_t num_threads = omp_get_num_threads();
+
+    for (size_t iter = first_iter; iter < max_iterations_; ++iter) {
+      #pragma omp master
       {
-        const auto thread_num = omp_get_thread_num();
-
-        if (thread_num < max_threads()) {
-          // Calculate and store the relaxed rotation for each rotation pair.
-          for (size_t rp = chunk_indices[thread_num];
-               rp != chunk_indices[thread_num + 1];
-               ++rp) {
-            MatrixIndexPair indices = {
-              .type = MatrixIndexPair::PairType::COLUMNS,
-              .first = static_cast<size_t>(rotation_pairs(0, rp)),
-              .second = static_cast<size_t>(rotation_pairs(1, rp))
-            };
+        rs_it = tourney.begin();
+        max_abs_sine = 0.0;
+        sum_sq_sines = 0.0;
+      }
+
+      // Position of the first rotation pair of the group in the iteration.
+      size_t iter_offset = 0;
+
+      // Iterate over groups of rotation sets.
+      for (size_t gr = 0; gr != num_groups_; ++gr) {
+        // Index of the group counted from the beginning of the actuation.
+        const size_t stamp = iter * num_groups_ + gr;
+
+        // Matrix of relaxed rotation cosines and sines at the top and bottom
+        // rows, respectively, for rotation pairs, which is kept for the
+        // group across iterations so that its gathering can be persistent.
+        Mat<real_t> &cosine_sine = group_cosine_sines[gr];
+
+        #pragma omp master
+        {
+          rotation_pairs.reset();
+          block_rounds.clear();
+          stage_bounds.assign(1, 0);
+
+          // Concatenate rotation sets (or rotation pairs of block rounds) in
+          // the group.
+          for (size_t rs = 0; rs != group_sizes[gr]; ++rs) {
+            if (is_block) {
+              AppendBlockRound(
+                  *rs_it, block_bounds, rotation_pairs, block_rounds);
+
+              ++rs_it;
+            } else {
+              rotation_pairs = arma::join_horiz(
+                  rotation_pairs, ordering->NextRotationSet());
+
+              // Rotation sets can have different numbers of pairs, and a
+              // rotation set without pairs is not a stage.
+              if (is_staged_by_set &&
+                  rotation_pairs.n_cols != stage_bounds.back()) {
+                stage_bounds.push_back(rotation_pairs.n_cols);
+              }
+            }
+          }
+
+          if (!is_staged_by_set &&
+              rotation_pairs.n_cols != stage_bounds.back()) {
+            stage_bounds.push_back(rotation_pairs.n_cols);
+          }
+
+          if (cosine_sine.n_cols != rotation_pairs.n_cols ||
+              group_stage_bounds[gr] != stage_bounds) {
+            cosine_sine.set_size(2, rotation_pairs.n_cols);
+            group_gathers[gr].clear();
+            group_stage_bounds[gr] = stage_bounds;
+          }
 
+          if (is_inquiry_skippable &&
+              skipped_stamps.size() < iter_offset + rotation_pairs.n_cols) {
+            skipped_angles.resize(iter_offset + rotation_pairs.n_cols, 0.0);
+            skipped_stamps.resize(iter_offset + rotation_pairs.n_cols, 0);
+          }
+
+          if (options_.is_dynamic_inquiry) {
+            // Rotation pairs that are not inquired by this MPI process
+            // remain zero for the reduction.
+            cosine_sine.zeros();
+          }
+        }
+
+        #pragma omp barrier
+
+        // Inquires the rotation pairs in a range as a batch and stores their
+        // relaxed rotations. Statistics of the unrelaxed rotations are
+        // accumulated to the given variables.
+        const auto inquire_range = [&](
+            size_t rp_first,
+            size_t rp_last,
+            real_t &range_max_abs_sine,
+            real_t &range_sum_sq_sines) -> void {
+          // Positions of the rotation pairs to inquire.
+          vector<size_t> positions;
+          positions.reserve(rp_last - rp_first);
+
+          // Index pairs to inquire, corresponding by column to the positions.
+          Mat<arma::uword> index_pairs(2, rp_last - rp_first);
+
+          for (size_t rp = rp_first; rp != rp_last; ++rp) {
             // Ensure the first index is not greater than the second.
-            if (indices.first > indices.second) {
-              std::swap(indices.first, indices.second);
+            const auto first =
+                std::min(rotation_pairs(0, rp), rotation_pairs(1, rp));
+            const auto second =
+                std::max(rotation_pairs(0, rp), rotation_pairs(1, rp));
+
+            // Whether the pair includes the dummy index.
+            const bool is_dummy = first == -1;
+
+            // Position of the rotation pair in the iteration.
+            const size_t position = iter_offset + rp;
+
+            // Whether the rotation is known to be negligible without
+            // inquiry, since neither vector has been rotated since the pair
+            // was last inquired and skipped, and its unrelaxed angle from
+            // then is still negligible at the current relaxation and
+            // threshold.
+            const bool is_known_negligible = !is_dummy &&
+                is_inquiry_skippable &&
+                skipped_stamps[position] != 0 &&
+                rotated_stamps[first] < skipped_stamps[position] &&
+                rotated_stamps[second] < skipped_stamps[position] &&
+                (1.0 - relaxation) * std::abs(skipped_angles[position]) <
+                    threshold;
+
+            if (is_known_negligible) {
+              // Unrelaxed rotation is the same as when it was inquired, so it
+              // contributes to the statistics as if it were inquired again.
+              const auto sine = std::sin(skipped_angles[position]);
+
+              range_max_abs_sine =
+                  std::fmax(range_max_abs_sine, std::abs(sine));
+
+              range_sum_sq_sines += sine * sine;
             }
 
-            if (indices.first == -1 || indices.second == -1) {
+            if (is_dummy || is_known_negligible) {
               cosine_sine(0, rp) = 1.0;
               cosine_sine(1, rp) = 0.0;
-            } else {
-              const IndexedVectorPair<T> vectors = {
-                .indices = indices,
-                .first = Col<T>(
-                    curr_matrix.colptr(indices.first),
-                    curr_matrix.n_rows,
-                    false,
-                    true),
-                .second = Col<T>(
-                    curr_matrix.colptr(indices.second),
-                    curr_matrix.n_rows,
-                    false,
-                    true)
-              };
-
-              // Unrelaxed rotation.
-              const auto rotation_spec = inquiry_fn(vectors);
-
-              const auto relaxed_angle = (1.0 - relaxation) *
-                  std::atan2(rotation_spec.sine, rotation_spec.cosine);
 
+              continue;
+            }
+
+            index_pairs(0, positions.size()) = first;
+            index_pairs(1, positions.size()) = second;
+
+            positions.push_back(rp);
+          }
+
+          if (positions.empty()) {
+            return;
+          }
+
+          index_pairs.resize(2, positions.size());
+
+          // Unrelaxed rotations corresponding by column to the index pairs.
+          vector<RotationMatrixSpec> rotation_specs(positions.size());
+
+          batch_inquiry_fn(
+              is_by_row ?
+                  MatrixIndexPair::PairType::ROWS :
+                  MatrixIndexPair::PairType::COLUMNS,
+              index_pairs,
+              curr_matrix,
+              rotation_specs);
+
+          for (size_t p = 0; p != positions.size(); ++p) {
+            const auto rp = positions[p];
+            const auto &rotation_spec = rotation_specs[p];
+
+            range_max_abs_sine =
+                std::fmax(range_max_abs_sine, std::abs(rotation_spec.sine));
+
+            range_sum_sq_sines += rotation_spec.sine * rotation_spec.sine;
+
+            const auto angle =
+                std::atan2(rotation_spec.sine, rotation_spec.cosine);
+
+            const auto relaxed_angle = (1.0 - relaxation) * angle;
+
+            if (is_threshold && std::abs(relaxed_angle) < threshold) {
+              cosine_sine(0, rp) = 1.0;
+              cosine_sine(1, rp) = 0.0;
+
+              if (is_inquiry_skippable) {
+                skipped_angles[iter_offset + rp] = angle;
+                skipped_stamps[iter_offset + rp] = stamp + 1;
+              }
+            } else {
               cosine_sine(0, rp) = std::cos(relaxed_angle);
               cosine_sine(1, rp) = std::sin(relaxed_angle);
             }
           }
+        };
+
+        // Rotation statistics of this thread in the group.
+        real_t thread_max_abs_sine = 0.0;
+        real_t thread_sum_sq_sines = 0.0;
+
+        if (options_.is_dynamic_inquiry) {
+          // Number of rotation pairs to claim at a time.
+          const size_t claim_size =
+              options_.inquiry_chunk_size * max_threads();
+
+          // Claim rotation pairs from the shared counter until they are
+          // exhausted. Nothing is claimed if the group has no rotation sets,
+          // such as when there are more groups than rotation sets, since a
+          // failed claim would not be synchronized with the claims of the
+          // next group by any exchange of this group.
+          while (rotation_pairs.n_cols != 0) {
+            #pragma omp master
+            {
+              const unsigned long long increment = claim_size;
+              unsigned long long claim_value;
+
+              MPI_Fetch_and_op(
+                  &increment, &claim_value, MPI_UNSIGNED_LONG_LONG,
+                  0, 0, MPI_SUM, counter_win);
+
+              MPI_Win_flush(0, counter_win);
+
+              claim_value -= counter_base;
+
+              is_claimed = claim_value < rotation_pairs.n_cols;
+
+              if (is_claimed) {
+                claim_first = claim_value;
+                claim_last = std::min<size_t>(
+                    claim_first + claim_size, rotation_pairs.n_cols);
+              }
+            }
+
+            #pragma omp barrier
+
+            if (!is_claimed) {
+              break;
+            }
+
+            // Number of chunks of rotation pairs in the claim.
+            const size_t num_chunks =
+                (claim_last - claim_first + options_.inquiry_chunk_size - 1) /
+                options_.inquiry_chunk_size;
+
+            // Claim is not replaced until all threads have passed the
+            // implicit barrier at the end of the loop.
+            #pragma omp for schedule(dynamic)
+            for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+              const size_t chunk_first =
+                  claim_first + chunk * options_.inquiry_chunk_size;
+
+              inquire_range(
+                  chunk_first,
+                  std::min(
+                      chunk_first + options_.inquiry_chunk_size, claim_last),
+                  thread_max_abs_sine,
+                  thread_sum_sq_sines);
+            }
+          }
+        } else {
+          // Delimitation of rotation pairs by MPI processes.
+          const auto batch_indices = GroupIndices(
+              0, rotation_pairs.n_cols, mpi_comm_size_);
+
+          // Delimitation of rotation pairs by threads.
+          const auto chunk_indices = GroupIndices(
+              batch_indices[mpi_rank_],
+              batch_indices[mpi_rank_ + 1],
+              num_threads);
+
+          inquire_range(
+              chunk_indices[thread_num],
+              chunk_indices[thread_num + 1],
+              thread_max_abs_sine,
+              thread_sum_sq_sines);
+        }
+
+        #pragma omp critical
+        {
+          max_abs_sine = std::fmax(max_abs_sine, thread_max_abs_sine);
+          sum_sq_sines += thread_sum_sq_sines;
+        }
+
+        // Ensure the relaxed rotations of this MPI process are complete.
+        #pragma omp barrier
+
+        // Number of stages of the group.
+        const size_t num_stages = stage_bounds.size() - 1;
+
+        // Start exchanging the relaxed rotations of all stages, each of
+        // which is waited for just before it is applied.
+        #pragma omp master
+        {
+          if (options_.is_dynamic_inquiry) {
+            // Each MPI process has claimed one more time than its successful
+            // claims, so the counter has advanced by a known amount.
+            const size_t claim_size =
+                options_.inquiry_chunk_size * max_threads();
+
+            // Counter has not advanced if the group has no rotation pairs.
+            if (rotation_pairs.n_cols != 0) {
+              counter_base +=
+                  ((rotation_pairs.n_cols + claim_size - 1) / claim_size +
+                   mpi_comm_size_) * claim_size;
+            }
+
+            stage_reductions.assign(num_stages, MPI_REQUEST_NULL);
+
+            // Combine the relaxed rotations, each of which was computed by
+            // exactly one MPI process.
+            for (size_t stage = 0; stage != num_stages; ++stage) {
+              MPI_Iallreduce(
+                  MPI_IN_PLACE,
+                  cosine_sine.colptr(stage_bounds[stage]),
+                  (stage_bounds[stage + 1] - stage_bounds[stage]) * 2,
+                  MPI_DOUBLE, MPI_SUM, mpi_comm_,
+                  &stage_reductions[stage]);
+            }
+          } else {
+            if (group_gathers[gr].empty()) {
+              // Delimitation of rotation pairs by MPI processes.
+              const auto batch_indices = GroupIndices(
+                  0, rotation_pairs.n_cols, mpi_comm_size_);
+
+              for (size_t stage = 0; stage != num_stages; ++stage) {
+                // Number of elements of the relaxed rotations of the stage
+                // from each MPI process.
+                vector<int> recv_counts(mpi_comm_size_);
+
+                // Displacement of the relaxed rotations of the stage from
+                // each MPI process relative to the stage.
+                vector<int> displs(mpi_comm_size_);
+
+                for (int rank = 0; rank != mpi_comm_size_; ++rank) {
+                  const size_t rp_first = std::min(
+                      std::max(batch_indices[rank], stage_bounds[stage]),
+                      stage_bounds[stage + 1]);
+
+                  const size_t rp_last = std::max(
+                      std::min(
+                          batch_indices[rank + 1], stage_bounds[stage + 1]),
+                      rp_first);
+
+                  recv_counts[rank] = (rp_last - rp_first) * 2;
+                  displs[rank] = (rp_first - stage_bounds[stage]) * 2;
+                }
+
+                group_gathers[gr].emplace_back(
+                    new MpiPersistentAllgatherv(
+                        mpi_comm_,
+                        cosine_sine.colptr(stage_bounds[stage]),
+                        recv_counts, displs, MPI_DOUBLE));
+              }
+            }
+
+            // Gather the relaxed rotations of each stage from all MPI
+            // processes in a collective that is set up once for the group.
+            for (const auto &gather : group_gathers[gr]) {
+              gather->Start();
+            }
+          }
+        }
+
+        for (size_t stage = 0; stage != num_stages; ++stage) {
+          #pragma omp master
+          {
+            if (options_.is_dynamic_inquiry) {
+              MPI_Wait(&stage_reductions[stage], MPI_STATUS_IGNORE);
+            } else {
+              group_gathers[gr][stage]->Wait();
+            }
+          }
+
+          #pragma omp barrier
+
+          // Rotation pairs of the stage.
+          const Mat<long long> stage_pairs(
+              rotation_pairs.colptr(stage_bounds[stage]),
+              2,
+              stage_bounds[stage + 1] - stage_bounds[stage],
+              false,
+              true);
+
+          // Relaxed rotations of the stage.
+          const Mat<real_t> stage_cosine_sine(
+              cosine_sine.colptr(stage_bounds[stage]),
+              2,
+              stage_pairs.n_cols,
+              false,
+              true);
+
+          if (is_block) {
+            // Apply the accumulated rotations of each block round in a
+            // distributed manner.
+            for (const auto &block_round : block_rounds) {
+              if (!is_by_row) {
+                DistApplyBlockRotations(
+                    block_round, stage_pairs, stage_cosine_sine, true,
+                    curr_matrix);
+              }
+
+              if (sidedness_ != JacobiSidedness::ONE_SIDED_RIGHT) {
+                DistApplyBlockRotations(
+                    block_round, stage_pairs, stage_cosine_sine, false,
+                    curr_matrix);
+              }
+
+              if (rotation) {
+                DistApplyBlockRotations(
+                    block_round, stage_pairs, stage_cosine_sine, true,
+                    *rotation);
+              }
+            }
+          } else if (options_.is_wavefront) {
+            // Rotations from the left commute with those from the right, so
+            // all column rotations in the group can be applied before the
+            // row rotations.
+            if (!is_by_row) {
+              DistApplyRotationGroup(
+                  stage_pairs, stage_cosine_sine, true, curr_matrix);
+            }
+
+            if (sidedness_ != JacobiSidedness::ONE_SIDED_RIGHT) {
+              DistApplyRotationGroup(
+                  stage_pairs, stage_cosine_sine, false, curr_matrix);
+            }
+
+            if (rotation) {
+              DistApplyRotationGroup(
+                  stage_pairs, stage_cosine_sine, true, *rotation);
+            }
+          } else {
+            // Apply the rotations in the rotation set in a distributed
+            // manner.
+            if (!is_by_row) {
+              DistApplyRotationSet(
+                  stage_pairs, stage_cosine_sine, true, curr_matrix);
+            }
+
+            if (sidedness_ != JacobiSidedness::ONE_SIDED_RIGHT) {
+              DistApplyRotationSet(
+                  stage_pairs, stage_cosine_sine, false, curr_matrix);
+            }
+
+            if (rotation) {
+              DistApplyRotationSet(
+                  stage_pairs, stage_cosine_sine, true, *rotation);
+            }
+          }
+        }
+
+        iter_offset += rotation_pairs.n_cols;
+
+        #pragma omp master
+        {
+          try {
+            if (!is_block) {
+              ordering->Update(rotation_pairs, cosine_sine);
+            }
+
+            // Record the rotated vectors.
+            if (is_inquiry_skippable) {
+              for (size_t rp = 0; rp != rotation_pairs.n_cols; ++rp) {
+                const RotationMatrixSpec rotation_spec = {
+                  .cosine = cosine_sine(0, rp),
+                  .sine = cosine_sine(1, rp)
+                };
+
+                if (!IsIdentityRotation(rotation_spec)) {
+                  rotated_stamps[rotation_pairs(0, rp)] = stamp + 1;
+                  rotated_stamps[rotation_pairs(1, rp)] = stamp + 1;
+                }
+              }
+            }
+
+            if (relaxation_policy) {
+              // Sum of the squares of the sines of the unrelaxed rotations in
+              // the group, which is recovered from the relaxed rotations so
+              // that it is the same at all MPI processes.
+              real_t group_sum_sq_sines = 0.0;
+
+              for (size_t rp = 0; rp != rotation_pairs.n_cols; ++rp) {
+                const auto sine = std::sin(
+                    std::atan2(cosine_sine(1, rp), cosine_sine(0, rp)) /
+                    (1.0 - relaxation));
+
+                group_sum_sq_sines += sine * sine;
+              }
+
+              relaxation = relaxation_policy->NextRelaxation(
+                  iter, gr, relaxation, group_sum_sq_sines);
+            } else {
+              relaxation = relax_fn_(iter, relaxation, gr);
+            }
+
+            if (relaxation < 0.0 || relaxation >= 1.0) {
+              throw std::domain_error(
+                  "Relaxation parameter is not in the interval [0, 1).");
+            }
+          } catch (...) {
+            // Relaxation is the same at all MPI processes, so all of them
+            // stop.
+            stop_exception = std::current_exception();
+            is_stopped = true;
+          }
+        }
+
+        #pragma omp barrier
+
+        if (is_stopped) {
+          break;
         }
       }
 
-      // Broadcast the relaxed rotations.
-      for (int rank = 0; rank != mpi_comm_size_; ++rank) {
-        // Number of elements to broadcast.
-        const size_t num_elements =
-            (batch_indices[rank + 1] - batch_indices[rank]) * 2;
-
-        MPI_Bcast(
-            cosine_sine.colptr(batch_indices[rank]),
-            num_elements,
-            MPI_DOUBLE,
-            rank,
-            mpi_comm_);
+      if (is_stopped) {
+        break;
+      }
+
+      #pragma omp master
+      {
+        MPI_Allreduce(
+            MPI_IN_PLACE, &max_abs_sine, 1, MPI_DOUBLE, MPI_MAX, mpi_comm_);
+
+        MPI_Allreduce(
+            MPI_IN_PLACE, &sum_sq_sines, 1, MPI_DOUBLE, MPI_SUM, mpi_comm_);
+
+        retval.max_abs_sine = max_abs_sine;
+        retval.sum_sq_sines = sum_sq_sines;
       }
 
-      const auto num_pairs_per_round = tourney.num_pairs_per_round(true);
+      bool has_converged = false;
 
-      // Apply the rotations in each rotation set in a distributed manner.
-      for (size_t start_rp = 0;
-           start_rp != rotation_pairs.n_cols;
-           start_rp += num_pairs_per_round) {
+      switch (criterion) {
+        case ConvergenceCriterion::MATRICES:
+          #pragma omp master
+          {
+            has_converged = convergence_checker_(*prev_matrix, curr_matrix);
 
-        const Mat<long long> rotation_set(
-            rotation_pairs.colptr(start_rp),
-            2,
-            num_pairs_per_round,
-            false,
-            true);
+            MPI_Allreduce(
+                MPI_IN_PLACE, &has_converged, 1, MPI_CXX_BOOL, MPI_LAND,
+                mpi_comm_);
+          }
 
-        vector<RotationMatrixSpec> rotation_specs;
+          break;
+        case ConvergenceCriterion::ROTATIONS:
+          #pragma omp master
+          {
+            has_converged = max_abs_sine <= options_.convergence_tol;
+          }
 
-        // Populate the rotation specs.
-        for (size_t rp = start_rp;
-             rp != start_rp + num_pairs_per_round;
-             ++rp) {
-          RotationMatrixSpec rotation_spec = {
-            .cosine = cosine_sine(0, rp),
-            .sine = cosine_sine(1, rp)
-          };
+          break;
+        case ConvergenceCriterion::FROBENIUS:
+          has_converged = DistFrobeniusConverged(
+              curr_matrix, *prev_matrix, frobenius_sq_norms);
+          break;
+      }
 
-          rotation_specs.push_back(rotation_spec);
+      #pragma omp master
+      {
+        retval.num_iters = iter + 1;
+
+        threshold *= options_.skip_threshold_decay;
+
+        if (has_converged) {
+          retval.has_converged = true;
+          is_stopped = true;
+        } else if (criterion == ConvergenceCriterion::MATRICES) {
+          parallel::memory::Copy(
+              host_based_comms_.intrahost(),
+              curr_matrix.memptr(),
+              prev_matrix->memptr(),
+              curr_matrix.n_elem * sizeof(T));
         }
 
-        DistApplyRotationSet(rotation_set, rotation_specs, true, curr_matrix);
+        if (!is_stopped &&
+            !options_.checkpoint_path.empty() &&
+            (iter + 1) % options_.checkpoint_interval == 0 &&
+            iter + 1 != max_iterations_) {
+          // Ensure all rotations of the iteration are in the shared memory.
+          MPI_Barrier(host_based_comms_.intrahost());
+
+          // Previous checkpoint must be written before it is replaced, and a
+          // failure at any host stops the actuation at every MPI process.
+          if (!is_checkpoint_written()) {
+            has_checkpoint_failed = true;
+            is_stopped = true;
+          } else if (is_checkpoint_writer) {
+            // Copy of the state that is written in the background.
+            const auto checkpoint = std::make_shared<Checkpoint<T>>();
+
+            checkpoint->matrix = curr_matrix;
+
+            if (rotation) {
+              checkpoint->rotation = *rotation;
+            }
 
-        if (sidedness_ == JacobiSidedness::TWO_SIDED) {
-          DistApplyRotationSet(
-              rotation_set, rotation_specs, false, curr_matrix);
+            checkpoint->num_iters = iter + 1;
+            checkpoint->relaxation = relaxation;
+            checkpoint->skip_threshold = threshold;
+            checkpoint->max_abs_sine = max_abs_sine;
+            checkpoint->sum_sq_sines = sum_sq_sines;
+
+            checkpoint_writing = std::async(
+                std::launch::async,
+                [checkpoint](const std::string &path) -> void {
+                  WriteCheckpoint(path, *checkpoint);
+                },
+                checkpoint_path);
+          }
         }
       }
 
-      relaxation = relax_fn_(iter, relaxation, gr);
+      #pragma omp barrier
 
-      if (relaxation < 0.0 || relaxation >= 1.0) {
-        throw std::domain_error(
-            "Relaxation parameter is not in the interval [0, 1).");
+      if (is_stopped) {
+        break;
       }
     }
+  }
 
-    auto has_converged = convergence_checker_(prev_matrix, curr_matrix);
+  if (stop_exception) {
+    if (options_.is_dynamic_inquiry) {
+      MPI_Win_unlock_all(counter_win);
+      MPI_Win_free(&counter_win);
+    }
 
-    MPI_Allreduce(
-        MPI_IN_PLACE, &has_converged, 1, MPI_CXX_BOOL, MPI_LAND, mpi_comm_);
+    std::rethrow_exception(stop_exception);
+  }
 
-    retval.num_iters = iter + 1;
+  if (!options_.checkpoint_path.empty() && !has_checkpoint_failed) {
+    has_checkpoint_failed = !is_checkpoint_written();
+  }
 
-    if (has_converged) {
-      retval.has_converged = true;
-      break;
-    } else {
-      parallel::memory::Copy(
-          host_based_comms_.intrahost(),
-          curr_matrix.memptr(),
-          prev_matrix.memptr(),
-          curr_matrix.n_elem * sizeof(T));
-    }
+  if (options_.is_dynamic_inquiry) {
+    MPI_Win_unlock_all(counter_win);
+    MPI_Win_free(&counter_win);
   }
 
   MPI_Barrier(mpi_comm_);
 
+  if (has_checkpoint_failed) {
+    throw std::runtime_error(
+        "Checkpoint cannot be written: " + options_.checkpoint_path);
+  }
+
   retval.transform = Mat<T>(
       curr_matrix.memptr(),
       curr_matrix.n_rows,
       curr_matrix.n_cols);
 
+  if (rotation) {
+    retval.rotation = Mat<T>(
+        rotation->memptr(),
+        rotation->n_rows,
+        rotation->n_cols);
+  }
+
+  return retval;
+}
+
+template <typename T>
+Result<T> Actuator<T>::Actuate(
+    const Mat<T> &input,
+    BatchInquiryFn batch_inquiry_fn,
+    typename Actuator<typename SinglePrecision<T>::type>::BatchInquiryFn
+        single_batch_inquiry_fn) {
+  using single_t = typename SinglePrecision<T>::type;
+
+  // Options of the single-precision iterations, which end at the switching
+  // sine and always accumulate their rotations.
+  ActuatorOptions single_options = options_;
+  single_options.convergence_criterion = ConvergenceCriterion::ROTATIONS;
+  single_options.convergence_tol = options_.single_precision_switch_sine;
+  single_options.skip_threshold = std::fmin(
+      options_.skip_threshold, options_.single_precision_switch_sine);
+  single_options.is_rotation_accumulated = true;
+  single_options.checkpoint_path.clear();
+
+  Actuator<single_t> single_actuator(
+      mpi_comm_,
+      max_threads_,
+      sidedness_,
+      init_relax_,
+      num_groups_,
+      max_iterations_,
+      relax_fn_,
+      [](const Mat<single_t> &, const Mat<single_t> &) -> bool {
+        return false;
+      },
+      single_options);
+
+  const auto single_result = single_actuator.Actuate(
+      arma::conv_to<Mat<single_t>>::from(input), single_batch_inquiry_fn);
+
+  // Accumulated rotation of the single-precision iterations, which is
+  // orthogonal only to single precision.
+  const Mat<real_t> single_rotation = arma::conv_to<Mat<real_t>>::from(
+      Mat<typename arma::get_pod_type<single_t>::result>(
+          arma::real(single_result.rotation)));
+
+  // Nearest orthogonal matrix to the accumulated rotation from its singular
+  // value decomposition.
+  Mat<real_t> left_sing_vecs;
+  Mat<real_t> right_sing_vecs;
+  Col<real_t> sing_vals;
+
+  arma::svd(left_sing_vecs, sing_vals, right_sing_vecs, single_rotation);
+
+  // Real type in the precision of the elements.
+  using pod_t = typename arma::get_pod_type<T>::result;
+
+  const Mat<pod_t> rotation = arma::conv_to<Mat<pod_t>>::from(
+      Mat<real_t>(left_sing_vecs * right_sing_vecs.t()));
+
+  // Input matrix transformed by the rotation in double precision.
+  Mat<T> start;
+
+  switch (sidedness_) {
+    case JacobiSidedness::ONE_SIDED_RIGHT:
+      start = multiply_real_right(input, rotation);
+      break;
+    case JacobiSidedness::ONE_SIDED_LEFT:
+      start = multiply_real_left(Mat<pod_t>(rotation.t()), input);
+      break;
+    case JacobiSidedness::TWO_SIDED:
+      start = multiply_real_left(
+          Mat<pod_t>(rotation.t()), multiply_real_right(input, rotation));
+      break;
+  }
+
+  auto retval = Actuate(start, batch_inquiry_fn);
+
+  retval.num_iters += single_result.num_iters;
+
+  if (options_.is_rotation_accumulated) {
+    retval.rotation = multiply_real_left(rotation, retval.rotation);
+  }
+
+  return retval;
+}
+
+template <typename T>
+vector<Result<T>> Actuator<T>::Actuate(
+    const vector<Mat<T>> &inputs,
+    const vector<BatchInquiryFn> &batch_inquiry_fns,
+    const vector<std::shared_ptr<PairOrdering>> &orderings) {
+  assert(!inputs.empty());
+  assert(batch_inquiry_fns.size() == inputs.size());
+
+  if (sidedness_ != JacobiSidedness::ONE_SIDED_RIGHT) {
+    throw std::invalid_argument(
+        "GRS of several problems is not one-sided from the right.");
+  }
+
+  const size_t num_problems = inputs.size();
+
+  // Number of columns of each problem.
+  vector<size_t> num_problem_cols;
+
+  // Index of the first column of each problem in the concatenated matrix,
+  // followed by the total number of columns.
+  vector<size_t> offsets(1, 0);
+
+  for (const auto &input : inputs) {
+    if (input.n_rows != inputs.front().n_rows || input.n_cols < 2) {
+      throw std::length_error(
+          "Invalid size of an input matrix of several problems.");
+    }
+
+    num_problem_cols.push_back(input.n_cols);
+    offsets.push_back(offsets.back() + input.n_cols);
+  }
+
+  // Input matrices concatenated by columns.
+  Mat<T> concat_input(inputs.front().n_rows, offsets.back());
+
+  for (size_t p = 0; p != num_problems; ++p) {
+    concat_input.cols(offsets[p], offsets[p + 1] - 1) = inputs[p];
+  }
+
+  // Batched inquiry function that divides a batch by the problems and
+  // inquires each problem on a view of its columns.
+  BatchInquiryFn concat_inquiry_fn = [&batch_inquiry_fns, &offsets](
+      MatrixIndexPair::PairType pair_type,
+      const Mat<arma::uword> &index_pairs,
+      const Mat<T> &matrix,
+      vector<RotationMatrixSpec> &rotation_specs) -> void {
+    // Index of the problem of a column.
+    const auto problem_of = [&offsets](arma::uword index) -> size_t {
+      return std::upper_bound(offsets.begin(), offsets.end(), index) -
+          offsets.begin() - 1;
+    };
+
+    // Positions of the pairs of each problem in the batch.
+    vector<vector<size_t>> problem_positions(batch_inquiry_fns.size());
+
+    for (size_t pos = 0; pos != index_pairs.n_cols; ++pos) {
+      const auto p = problem_of(index_pairs(0, pos));
+
+      if (problem_of(index_pairs(1, pos)) == p) {
+        problem_positions[p].push_back(pos);
+      } else {
+        rotation_specs[pos] = CreateIdentityRotation();
+      }
+    }
+
+    for (size_t p = 0; p != problem_positions.size(); ++p) {
+      const auto &positions = problem_positions[p];
+
+      if (positions.empty()) {
+        continue;
+      }
+
+      Mat<arma::uword> problem_index_pairs(2, positions.size());
+
+      for (size_t i = 0; i != positions.size(); ++i) {
+        problem_index_pairs(0, i) = index_pairs(0, positions[i]) - offsets[p];
+        problem_index_pairs(1, i) = index_pairs(1, positions[i]) - offsets[p];
+      }
+
+      const Mat<T> problem_matrix(
+          const_cast<T *>(matrix.colptr(offsets[p])),
+          matrix.n_rows,
+          offsets[p + 1] - offsets[p],
+          false,
+          true);
+
+      vector<RotationMatrixSpec> problem_specs(positions.size());
+
+      batch_inquiry_fns[p](
+          pair_type, problem_index_pairs, problem_matrix, problem_specs);
+
+      for (size_t i = 0; i != positions.size(); ++i) {
+        rotation_specs[positions[i]] = problem_specs[i];
+      }
+    }
+  };
+
+  const auto concat_result = ActuateOrdered(
+      concat_input,
+      concat_inquiry_fn,
+      std::make_shared<MultiProblemOrdering>(num_problem_cols, orderings));
+
+  vector<Result<T>> retval(num_problems);
+
+  for (size_t p = 0; p != num_problems; ++p) {
+    auto &result = retval[p];
+
+    result.transform =
+        concat_result.transform.cols(offsets[p], offsets[p + 1] - 1);
+
+    result.num_iters = concat_result.num_iters;
+    result.has_converged = concat_result.has_converged;
+    result.max_abs_sine = concat_result.max_abs_sine;
+    result.sum_sq_sines = concat_result.sum_sq_sines;
+
+    // Accumulated rotation is block diagonal by the problems.
+    if (!concat_result.rotation.is_empty()) {
+      result.rotation = concat_result.rotation.submat(
+          offsets[p], offsets[p], offsets[p + 1] - 1, offsets[p + 1] - 1);
+    }
+  }
+
   return retval;
 }
 
@@ -345,94 +1530,438 @@ size_t Actuator<T>::max_threads() const {
   return max_threads_;
 }
 
+template <typename T>
+void Actuator<T>::IntrahostBarrier() const {
+  #pragma omp barrier
+
+  #pragma omp master
+  {
+    MPI_Barrier(host_based_comms_.intrahost());
+  }
+
+  #pragma omp barrier
+}
+
 template <typename T>
 void Actuator<T>::DistApplyRotationSet(
     const arma::Mat<long long> &rotation_set,
-    const std::vector<RotationMatrixSpec> &rotation_specs,
+    const arma::Mat<real_t> &cosine_sine,
     bool is_by_col,
     Mat<T> &matrix) const {
-  assert(!omp_in_parallel());
   assert(!rotation_set.is_empty());
   assert(rotation_set.n_rows == 2);
-  assert(rotation_specs.size() == rotation_set.n_cols);
+  assert(cosine_sine.n_rows == 2);
+  assert(cosine_sine.n_cols == rotation_set.n_cols);
+
+  const size_t thread_num = omp_get_thread_num();
+  const size_t num_threads = omp_get_num_threads();
 
   if (!is_by_col) {
-    Mat<T> matrix_st(matrix.st());
-    DistApplyRotationSet(rotation_set, rotation_specs, true, matrix_st);
-    matrix = matrix_st.st();
-    return;
-  }
+    // Subdivide the columns by MPI process.
+    const auto col_batches = GroupIndices(0, matrix.n_cols, intrahost_size_);
+
+    // Subdivide the batch of columns by thread.
+    const auto col_chunks = GroupIndices(
+        col_batches[intrahost_rank_],
+        col_batches[intrahost_rank_ + 1],
+        num_threads);
+
+    // Number of columns assigned to this thread.
+    const size_t num_cols =
+        col_chunks[thread_num + 1] - col_chunks[thread_num];
+
+    // Concurrently rotate the rows within the columns assigned to this
+    // thread.
+    for (size_t rp = 0; num_cols != 0 && rp != rotation_set.n_cols; ++rp) {
+      pair<long long, long long> rotation_pair(
+          rotation_set(0, rp), rotation_set(1, rp));
+
+      if (rotation_pair.first > rotation_pair.second) {
+        std::swap(rotation_pair.first, rotation_pair.second);
+      }
 
-  int intrahost_rank;
-  MPI_Comm_rank(host_based_comms_.intrahost(), &intrahost_rank);
+      const RotationMatrixSpec rotation_spec = {
+        .cosine = cosine_sine(0, rp),
+        .sine = cosine_sine(1, rp)
+      };
 
-  int intrahost_size;
-  MPI_Comm_size(host_based_comms_.intrahost(), &intrahost_size);
+      if (rotation_pair.first == -1 || IsIdentityRotation(rotation_spec)) {
+        continue;
+      }
+
+      ApplyGivensRotation(
+          rotation_spec,
+          num_cols,
+          matrix.colptr(col_chunks[thread_num]) + rotation_pair.first,
+          matrix.colptr(col_chunks[thread_num]) + rotation_pair.second,
+          matrix.n_rows);
+    }
+
+    // Wait for the MPI processes at this host to finish applying the
+    // rotations.
+    IntrahostBarrier();
+
+    return;
+  }
 
   // Subdivide the rotation set by MPI process.
   const auto rp_batches = GroupIndices(
-      0, rotation_specs.size(), intrahost_size);
+      0, rotation_set.n_cols, intrahost_size_);
 
   // Subdivide the batch of rotation pairs by thread.
   const auto rp_chunks = GroupIndices(
-      rp_batches[intrahost_rank],
-      rp_batches[intrahost_rank + 1],
-      max_threads());
+      rp_batches[intrahost_rank_],
+      rp_batches[intrahost_rank_ + 1],
+      num_threads);
+
+  // Concurrently rotate the columns assigned to this thread.
+  for (size_t rp = rp_chunks[thread_num];
+       rp != rp_chunks[thread_num + 1];
+       ++rp) {
+    pair<long long, long long> rotation_pair(
+        rotation_set(0, rp), rotation_set(1, rp));
+
+    if (rotation_pair.first > rotation_pair.second) {
+      std::swap(rotation_pair.first, rotation_pair.second);
+    }
+
+    const RotationMatrixSpec rotation_spec = {
+      .cosine = cosine_sine(0, rp),
+      .sine = cosine_sine(1, rp)
+    };
+
+    if (rotation_pair.first == -1 || IsIdentityRotation(rotation_spec)) {
+      continue;
+    }
+
+    ApplyGivensRotation(
+        rotation_spec,
+        matrix.n_rows,
+        matrix.colptr(rotation_pair.first),
+        matrix.colptr(rotation_pair.second));
+  }
 
-  // Concurrently rotate the columns assigned to this MPI process.
-  #pragma omp parallel default(shared)
+  // Wait for the MPI processes at this host to finish applying the rotations.
+  IntrahostBarrier();
+}
+
+template <typename T>
+bool Actuator<T>::DistFrobeniusConverged(
+    const Mat<T> &curr_matrix,
+    Mat<T> &prev_matrix,
+    real_t (&sq_norms)[2]) const {
+  assert(arma::size(curr_matrix) == arma::size(prev_matrix));
+
+  const size_t thread_num = omp_get_thread_num();
+  const size_t num_threads = omp_get_num_threads();
+
+  // Subdivide the columns by MPI process.
+  const auto col_batches =
+      GroupIndices(0, curr_matrix.n_cols, intrahost_size_);
+
+  // Subdivide the batch of columns by thread.
+  const auto col_chunks = GroupIndices(
+      col_batches[intrahost_rank_],
+      col_batches[intrahost_rank_ + 1],
+      num_threads);
+
+  #pragma omp master
   {
-    const auto thread_num = omp_get_thread_num();
+    sq_norms[0] = 0.0;
+    sq_norms[1] = 0.0;
+  }
 
-    // Number of rotations assigned to this thread.
-    const size_t num_rotations = thread_num < max_threads() ?
-        rp_chunks[thread_num + 1] - rp_chunks[thread_num] : 0;
+  #pragma omp barrier
 
-    if (num_rotations != 0) {
-      // Iterator to the beginning of the chunk of rotation specs.
-      auto spec_first = rotation_specs.begin();
-      std::advance(spec_first, rp_chunks[thread_num]);
+  // Squared Frobenius norms of the change and the current matrix over the
+  // columns assigned to this thread.
+  real_t thread_sq_norms[2] = {0.0, 0.0};
 
-      // Iterator to the end of the chunk of rotation specs for loop
-      // termination.
-      auto spec_last = spec_first;
+  for (size_t j = col_chunks[thread_num];
+       j != col_chunks[thread_num + 1];
+       ++j) {
+    const T *curr_col = curr_matrix.colptr(j);
+    T *prev_col = prev_matrix.colptr(j);
 
-      std::advance(spec_last, num_rotations);
+    for (size_t i = 0; i != curr_matrix.n_rows; ++i) {
+      thread_sq_norms[0] += std::norm(curr_col[i] - prev_col[i]);
+      thread_sq_norms[1] += std::norm(curr_col[i]);
 
-      // Iterator to the current rotation pair.
-      auto pair_it = rotation_set.begin_col(rp_chunks[thread_num]);
+      // Current matrix becomes the previous one for the next iteration.
+      prev_col[i] = curr_col[i];
+    }
+  }
 
-      // Apply the rotations assigned to this thread.
-      for (auto spec_it = spec_first;
-           spec_it != spec_last;
-           ++spec_it, std::advance(pair_it, 2)) {
-        pair<long long, long long> rotation_pair(*pair_it, *(pair_it + 1));
+  #pragma omp critical
+  {
+    sq_norms[0] += thread_sq_norms[0];
+    sq_norms[1] += thread_sq_norms[1];
+  }
 
-        if (rotation_pair.first > rotation_pair.second) {
-          std::swap(rotation_pair.first, rotation_pair.second);
-        }
+  #pragma omp barrier
+
+  // Each host has the whole matrix, so the reduction is within a host. It
+  // also waits for the MPI processes at this host to finish copying.
+  #pragma omp master
+  {
+    MPI_Allreduce(
+        MPI_IN_PLACE, sq_norms, 2, MPI_DOUBLE, MPI_SUM,
+        host_based_comms_.intrahost());
+  }
+
+  #pragma omp barrier
+
+  return std::sqrt(sq_norms[0]) <=
+      options_.convergence_tol * std::sqrt(sq_norms[1]);
+}
+
+template <typename T>
+void Actuator<T>::AppendBlockRound(
+    const Mat<long long> &block_round,
+    const vector<size_t> &block_bounds,
+    Mat<long long> &rotation_pairs,
+    vector<vector<BlockPair>> &block_rounds) {
+  assert(block_round.n_cols == 2);
+
+  vector<BlockPair> block_pairs;
+
+  // Rotation pairs of the block round as a list of index pairs.
+  vector<long long> round_pairs;
+
+  for (size_t bp = 0; bp != block_round.n_rows; ++bp) {
+    if (block_round(bp, 0) == -1 || block_round(bp, 1) == -1) {
+      continue;
+    }
+
+    BlockPair block_pair;
+
+    block_pair.first_begin = block_bounds[block_round(bp, 0)];
+    block_pair.first_end = block_bounds[block_round(bp, 0) + 1];
+    block_pair.second_begin = block_bounds[block_round(bp, 1)];
+    block_pair.second_end = block_bounds[block_round(bp, 1) + 1];
+    block_pair.rp_begin = rotation_pairs.n_cols + round_pairs.size() / 2;
 
-        if (rotation_pair.first == -1) {
+    const size_t first_size = block_pair.first_end - block_pair.first_begin;
+    const size_t size = first_size +
+        (block_pair.second_end - block_pair.second_begin);
+
+    // Indices of the vectors in the union of the blocks as competitors in
+    // a round-robin tournament.
+    RoundRobinTourney<long long> inner_tourney(size);
+
+    for (const auto &inner_round : inner_tourney) {
+      for (size_t rp = 0; rp != inner_round.n_rows; ++rp) {
+        if (inner_round(rp, 0) == -1 || inner_round(rp, 1) == -1) {
           continue;
         }
 
-        const auto &rotation_spec = *spec_it;
+        for (size_t k = 0; k != 2; ++k) {
+          const size_t local_index = inner_round(rp, k);
 
-        const auto row_rotation =
-            CreateGivensRotation(rotation_spec, 2, 0, 1);
+          round_pairs.push_back(
+              local_index < first_size ?
+              block_pair.first_begin + local_index :
+              block_pair.second_begin + local_index - first_size);
+        }
+      }
+    }
 
-        const uvec idxs = {
-          static_cast<size_t>(rotation_pair.first),
-          static_cast<size_t>(rotation_pair.second)
-        };
+    block_pair.rp_end = rotation_pairs.n_cols + round_pairs.size() / 2;
+    block_pairs.push_back(block_pair);
+  }
+
+  rotation_pairs = arma::join_horiz(
+      rotation_pairs,
+      Mat<long long>(round_pairs.data(), 2, round_pairs.size() / 2));
+
+  block_rounds.push_back(std::move(block_pairs));
+}
+
+template <typename T>
+void Actuator<T>::DistApplyBlockRotations(
+    const vector<BlockPair> &block_pairs,
+    const Mat<long long> &rotation_pairs,
+    const Mat<real_t> &cosine_sine,
+    bool is_by_col,
+    Mat<T> &matrix) const {
+  assert(rotation_pairs.n_rows == 2);
+  assert(cosine_sine.n_rows == 2);
+  assert(cosine_sine.n_cols == rotation_pairs.n_cols);
+
+  const size_t thread_num = omp_get_thread_num();
+  const size_t num_threads = omp_get_num_threads();
+
+  // Subdivide the block pairs by MPI process.
+  const auto bp_batches =
+      GroupIndices(0, block_pairs.size(), intrahost_size_);
+
+  // Subdivide the batch of block pairs by thread.
+  const auto bp_chunks = GroupIndices(
+      bp_batches[intrahost_rank_],
+      bp_batches[intrahost_rank_ + 1],
+      num_threads);
+
+  // Concurrently rotate the blocks assigned to this thread.
+  for (size_t bp = bp_chunks[thread_num];
+       bp != bp_chunks[thread_num + 1];
+       ++bp) {
+    const auto &block_pair = block_pairs[bp];
+
+    const size_t first_size = block_pair.first_end - block_pair.first_begin;
+    const size_t second_size =
+        block_pair.second_end - block_pair.second_begin;
+
+    // Real type in the precision of the elements.
+    using pod_t = typename arma::get_pod_type<T>::result;
+
+    // Accumulated rotations of the block pair as a real orthogonal matrix
+    // that postmultiplies the concatenated columns of the blocks.
+    Mat<pod_t> accum(
+        first_size + second_size, first_size + second_size,
+        arma::fill::eye);
+
+    // Index of a vector in the concatenated blocks.
+    const auto local_index = [&block_pair, first_size](long long index) {
+      return static_cast<size_t>(index) < block_pair.first_end &&
+          static_cast<size_t>(index) >= block_pair.first_begin ?
+          index - block_pair.first_begin :
+          first_size + index - block_pair.second_begin;
+    };
+
+    for (size_t rp = block_pair.rp_begin; rp != block_pair.rp_end; ++rp) {
+      pair<long long, long long> rotation_pair(
+          rotation_pairs(0, rp), rotation_pairs(1, rp));
+
+      if (rotation_pair.first > rotation_pair.second) {
+        std::swap(rotation_pair.first, rotation_pair.second);
+      }
+
+      const RotationMatrixSpec rotation_spec = {
+        .cosine = cosine_sine(0, rp),
+        .sine = cosine_sine(1, rp)
+      };
+
+      if (IsIdentityRotation(rotation_spec)) {
+        continue;
+      }
+
+      ApplyGivensRotation(
+          rotation_spec,
+          accum.n_rows,
+          accum.colptr(local_index(rotation_pair.first)),
+          accum.colptr(local_index(rotation_pair.second)));
+    }
+
+    if (is_by_col) {
+      const Mat<T> vectors(
+          arma::join_horiz(
+              matrix.cols(block_pair.first_begin, block_pair.first_end - 1),
+              matrix.cols(
+                  block_pair.second_begin, block_pair.second_end - 1)));
+
+      const Mat<T> rotated(multiply_real_right(vectors, accum));
+
+      matrix.cols(block_pair.first_begin, block_pair.first_end - 1) =
+          rotated.cols(0, first_size - 1);
+
+      matrix.cols(block_pair.second_begin, block_pair.second_end - 1) =
+          rotated.cols(first_size, rotated.n_cols - 1);
+    } else {
+      const Mat<T> vectors(
+          arma::join_vert(
+              matrix.rows(block_pair.first_begin, block_pair.first_end - 1),
+              matrix.rows(
+                  block_pair.second_begin, block_pair.second_end - 1)));
+
+      const Mat<T> rotated(
+          multiply_real_left(Mat<pod_t>(accum.st()), vectors));
+
+      matrix.rows(block_pair.first_begin, block_pair.first_end - 1) =
+          rotated.rows(0, first_size - 1);
+
+      matrix.rows(block_pair.second_begin, block_pair.second_end - 1) =
+          rotated.rows(first_size, rotated.n_rows - 1);
+    }
+  }
+
+  // Wait for the MPI processes at this host to finish applying the rotations.
+  IntrahostBarrier();
+}
+
+template <typename T>
+void Actuator<T>::DistApplyRotationGroup(
+    const Mat<long long> &rotation_pairs,
+    const Mat<real_t> &cosine_sine,
+    bool is_by_col,
+    Mat<T> &matrix) const {
+  assert(rotation_pairs.n_rows == 2);
+  assert(cosine_sine.n_rows == 2);
+  assert(cosine_sine.n_cols == rotation_pairs.n_cols);
+
+  const size_t thread_num = omp_get_thread_num();
+  const size_t num_threads = omp_get_num_threads();
+
+  // Number of elements of a vector, which are the rows for column rotations
+  // and the columns for row rotations.
+  const size_t vector_size = is_by_col ? matrix.n_rows : matrix.n_cols;
+
+  // Subdivide the elements of the vectors by MPI process.
+  const auto elem_batches = GroupIndices(0, vector_size, intrahost_size_);
+
+  // Subdivide the batch of elements by thread.
+  const auto elem_chunks = GroupIndices(
+      elem_batches[intrahost_rank_],
+      elem_batches[intrahost_rank_ + 1],
+      num_threads);
+
+  const size_t block_size = options_.wavefront_block_rows;
+
+  // End of the elements assigned to this thread.
+  const size_t chunk_last = elem_chunks[thread_num + 1];
+
+  // Apply the whole group to each block of elements in this chunk.
+  for (size_t block_first = elem_chunks[thread_num];
+       block_first < chunk_last;
+       block_first += block_size) {
+    const size_t num_block_elems =
+        std::min(block_size, chunk_last - block_first);
+
+    for (size_t rp = 0; rp != rotation_pairs.n_cols; ++rp) {
+      pair<long long, long long> rotation_pair(
+          rotation_pairs(0, rp), rotation_pairs(1, rp));
+
+      if (rotation_pair.first > rotation_pair.second) {
+        std::swap(rotation_pair.first, rotation_pair.second);
+      }
+
+      const RotationMatrixSpec rotation_spec = {
+        .cosine = cosine_sine(0, rp),
+        .sine = cosine_sine(1, rp)
+      };
+
+      if (rotation_pair.first == -1 || IsIdentityRotation(rotation_spec)) {
+        continue;
+      }
 
-        matrix.cols(idxs) = matrix.cols(idxs) * row_rotation.t();
+      if (is_by_col) {
+        ApplyGivensRotation(
+            rotation_spec,
+            num_block_elems,
+            matrix.colptr(rotation_pair.first) + block_first,
+            matrix.colptr(rotation_pair.second) + block_first);
+      } else {
+        ApplyGivensRotation(
+            rotation_spec,
+            num_block_elems,
+            matrix.colptr(block_first) + rotation_pair.first,
+            matrix.colptr(block_first) + rotation_pair.second,
+            matrix.n_rows);
       }
     }
   }
 
   // Wait for the MPI processes at this host to finish applying the rotations.
-  MPI_Barrier(host_based_comms_.intrahost());
+  IntrahostBarrier();
 }
 
 } // namespace grs
@@ -0,0 +1,142 @@
+#include "tanuki/parallel/grs/autotuner.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+#include <omp.h>
+
+#include "tanuki/parallel/mpi/mpi_hosts.h"
+
+namespace tanuki {
+namespace parallel {
+namespace grs {
+
+using std::ifstream;
+using std::istringstream;
+using std::ofstream;
+using std::string;
+using std::vector;
+
+using parallel::mpi::MpiHosts;
+
+bool TuningKey::operator<(const TuningKey &other) const {
+  return std::tie(num_rows, num_cols, num_procs, num_hosts) <
+      std::tie(other.num_rows, other.num_cols, other.num_procs,
+               other.num_hosts);
+}
+
+TuningFile::TuningFile(const string &path) : path_(path) {
+  ifstream ifs(path_);
+
+  if (!ifs) {
+    return;
+  }
+
+  string line;
+
+  while (std::getline(ifs, line)) {
+    if (line.find_first_not_of(" \t\r") == string::npos) {
+      continue;
+    }
+
+    istringstream iss(line);
+
+    TuningKey key;
+    TuningParams params;
+
+    if (!(iss >> key.num_rows >> key.num_cols >> key.num_procs
+              >> key.num_hosts >> params.num_groups >> params.max_threads
+              >> params.init_relax)) {
+      throw std::runtime_error("Invalid line in the tuning file: " + line);
+    }
+
+    tunings_[key] = params;
+  }
+}
+
+bool TuningFile::Contains(const TuningKey &key) const {
+  return tunings_.count(key) != 0;
+}
+
+const TuningParams &TuningFile::At(const TuningKey &key) const {
+  return tunings_.at(key);
+}
+
+void TuningFile::Store(const TuningKey &key, const TuningParams &params) {
+  tunings_[key] = params;
+
+  ofstream ofs(path_);
+
+  if (!ofs) {
+    throw std::runtime_error("Tuning file cannot be written: " + path_);
+  }
+
+  ofs << std::setprecision(std::numeric_limits<real_t>::max_digits10);
+
+  for (const auto &tuning : tunings_) {
+    ofs << tuning.first.num_rows << ' '
+        << tuning.first.num_cols << ' '
+        << tuning.first.num_procs << ' '
+        << tuning.first.num_hosts << ' '
+        << tuning.second.num_groups << ' '
+        << tuning.second.max_threads << ' '
+        << tuning.second.init_relax << '\n';
+  }
+
+  if (!ofs) {
+    throw std::runtime_error("Tuning file cannot be written: " + path_);
+  }
+}
+
+TuningKey CreateTuningKey(
+    MPI_Comm mpi_comm, size_t num_rows, size_t num_cols) {
+  const MpiHosts hosts(mpi_comm);
+
+  return {
+    .num_rows = num_rows,
+    .num_cols = num_cols,
+    .num_procs = hosts.size(),
+    .num_hosts = hosts.num_hosts()
+  };
+}
+
+TuningGrid CreateDefaultTuningGrid(MPI_Comm mpi_comm, size_t num_vectors) {
+  int mpi_comm_size;
+  MPI_Comm_size(mpi_comm, &mpi_comm_size);
+
+  // Maximum number of threads that is common to all MPI processes.
+  int common_max_threads = omp_get_max_threads();
+
+  MPI_Allreduce(
+      MPI_IN_PLACE, &common_max_threads, 1, MPI_INT, MPI_MIN, mpi_comm);
+
+  const size_t max_threads = common_max_threads;
+  const real_t init_relax = GrsOneSidedRelaxParam(num_vectors);
+
+  TuningGrid retval;
+
+  retval.num_groups = {
+    static_cast<size_t>(mpi_comm_size),
+    static_cast<size_t>(mpi_comm_size) * 2,
+    static_cast<size_t>(mpi_comm_size) * 4
+  };
+
+  retval.max_threads.push_back(max_threads);
+
+  if (max_threads / 2 != 0) {
+    retval.max_threads.push_back(max_threads / 2);
+  }
+
+  retval.init_relaxes = {init_relax, init_relax * 0.5, 0.0};
+
+  return retval;
+}
+
+} // namespace grs
+} // namespace parallel
+} // namespace tanuki
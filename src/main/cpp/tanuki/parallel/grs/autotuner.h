@@ -0,0 +1,269 @@
+#ifndef TANUKI_PARALLEL_GRS_AUTOTUNER_H
+#define TANUKI_PARALLEL_GRS_AUTOTUNER_H
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <armadillo>
+#include <mpi.h>
+
+#include "tanuki/number/types.h"
+#include "tanuki/parallel/grs/actuator.h"
+#include "tanuki/parallel/grs/jacobi_sidedness.h"
+
+namespace tanuki {
+namespace parallel {
+namespace grs {
+
+using arma::Mat;
+
+using tanuki::number::real_t;
+
+/**
+ *  @brief Parameters of the GRS actuator that are tuned.
+ */
+struct TuningParams final {
+ public:
+  /**
+   *  @brief Positive number of groups of rotation sets.
+   */
+  size_t num_groups;
+
+  /**
+   *  @brief Positive maximum number of threads.
+   */
+  size_t max_threads;
+
+  /**
+   *  @brief Initial relaxation parameter in the range \f$ [0, 1) \f$.
+   */
+  real_t init_relax;
+};
+
+/**
+ *  @brief Key of tuned parameters by the shape of the input matrix and the
+ *  layout of the MPI processes.
+ */
+struct TuningKey final {
+ public:
+  /**
+   *  @brief Number of rows of the input matrix.
+   */
+  size_t num_rows;
+
+  /**
+   *  @brief Number of columns of the input matrix.
+   */
+  size_t num_cols;
+
+  /**
+   *  @brief Number of MPI processes.
+   */
+  size_t num_procs;
+
+  /**
+   *  @brief Number of hosts.
+   */
+  size_t num_hosts;
+
+  /**
+   *  @brief Lexicographical order of the members.
+   */
+  bool operator<(const TuningKey &other) const;
+};
+
+/**
+ *  @brief Grid of the parameters to try in autotuning.
+ *
+ *  Every combination of the values is a trial configuration.
+ */
+struct TuningGrid final {
+ public:
+  /**
+   *  @brief Numbers of groups of rotation sets.
+   */
+  std::vector<size_t> num_groups;
+
+  /**
+   *  @brief Maximum numbers of threads.
+   */
+  std::vector<size_t> max_threads;
+
+  /**
+   *  @brief Initial relaxation parameters.
+   */
+  std::vector<real_t> init_relaxes;
+};
+
+/**
+ *  @brief Local file of tuned parameters.
+ *
+ *  Each line of the file is a tuning, with the members of the key followed by
+ *  those of the parameters, as whitespace-separated numbers in the order of
+ *  declaration.
+ */
+class TuningFile final {
+ public:
+  /**
+   *  @param path
+   *    Path to the file. If it exists, its tunings are loaded. If it cannot
+   *    be parsed, <tt>std::runtime_error</tt> is thrown.
+   */
+  explicit TuningFile(const std::string &path);
+
+  /**
+   *  @brief Whether the file has the parameters of a key.
+   */
+  bool Contains(const TuningKey &key) const;
+
+  /**
+   *  @brief Parameters of a key.
+   *
+   *  If the file does not have the key, <tt>std::out_of_range</tt> is thrown.
+   */
+  const TuningParams &At(const TuningKey &key) const;
+
+  /**
+   *  @brief Stores the parameters of a key, replacing any existing ones, and
+   *  writes the file.
+   *
+   *  If the file cannot be written, <tt>std::runtime_error</tt> is thrown.
+   */
+  void Store(const TuningKey &key, const TuningParams &params);
+
+ private:
+  /**
+   *  @brief Path to the file.
+   */
+  const std::string path_;
+
+  /**
+   *  @brief Tuned parameters by key.
+   */
+  std::map<TuningKey, TuningParams> tunings_;
+};
+
+/**
+ *  @brief Creates the tuning key of an input matrix.
+ *
+ *  All MPI processes must invoke this.
+ */
+TuningKey CreateTuningKey(MPI_Comm mpi_comm, size_t num_rows, size_t num_cols);
+
+/**
+ *  @brief Creates the default grid of the parameters.
+ *
+ *  Numbers of groups are one, two, and four times the number of MPI
+ *  processes. Maximum numbers of threads are the least
+ *  <tt>omp_get_max_threads()</tt> of the MPI processes and half of it, so
+ *  that the grid is the same across MPI processes. Initial relaxation
+ *  parameters are @link GrsOneSidedRelaxParam @endlink, half of it, and
+ *  zero.
+ *
+ *  All MPI processes must invoke this.
+ *
+ *  @param num_vectors
+ *    Number of vectors that are queried for rotations.
+ */
+TuningGrid CreateDefaultTuningGrid(MPI_Comm mpi_comm, size_t num_vectors);
+
+/**
+ *  @brief Determines the fastest parameters of the GRS actuator for an input
+ *  matrix by trial actuations.
+ *
+ *  Each combination of the grid is actuated on the input matrix for at most
+ *  <tt>trial_sweeps</tt> iterations until the maximum magnitude of the sines
+ *  of the unrelaxed rotations in an iteration does not exceed
+ *  <tt>trial_tol</tt>, and the slowest wall time of the MPI processes is
+ *  measured. Fastest configuration that converges is chosen. If none
+ *  converges, the configuration with the least maximum sine at the end is
+ *  chosen.
+ *
+ *  All MPI processes must invoke this outside any OpenMP parallel region.
+ *
+ *  @tparam T
+ *    Type of elements in an Armadillo matrix.
+ *
+ *  @param relax_fn
+ *    Relaxation function of the actuator. See @link Actuator @endlink.
+ *
+ *  @param options
+ *    Options of the actuator. Convergence criterion and tolerance are
+ *    replaced, the threshold of rotation angles is limited to the tolerance,
+ *    and checkpointing is disabled, for the trials.
+ */
+template <typename T>
+TuningParams Autotune(
+    MPI_Comm mpi_comm,
+    JacobiSidedness sidedness,
+    const Mat<T> &input,
+    typename Actuator<T>::BatchInquiryFn batch_inquiry_fn,
+    std::function<real_t(size_t, real_t, size_t)> relax_fn,
+    const ActuatorOptions &options,
+    const TuningGrid &grid,
+    size_t trial_sweeps = 3,
+    real_t trial_tol = 1.0e-2);
+
+/**
+ *  @brief Parameters of the GRS actuator for an input matrix from a tuning
+ *  file, which are autotuned and stored if the file does not have them.
+ *
+ *  Only the MPI process of rank zero reads and writes the file, and the
+ *  parameters are broadcast. See @link Autotune @endlink for the other
+ *  parameters.
+ *
+ *  All MPI processes must invoke this outside any OpenMP parallel region.
+ *
+ *  @param tuning_path
+ *    Path to the tuning file.
+ */
+template <typename T>
+TuningParams TunedParams(
+    MPI_Comm mpi_comm,
+    const std::string &tuning_path,
+    JacobiSidedness sidedness,
+    const Mat<T> &input,
+    typename Actuator<T>::BatchInquiryFn batch_inquiry_fn,
+    std::function<real_t(size_t, real_t, size_t)> relax_fn,
+    const ActuatorOptions &options,
+    const TuningGrid &grid,
+    size_t trial_sweeps = 3,
+    real_t trial_tol = 1.0e-2);
+
+/**
+ *  @brief Parameters of the GRS actuator from a tuning file by a given key,
+ *  which are autotuned and stored if the file does not have them.
+ *
+ *  It is for an input matrix that is derived from a problem of a different
+ *  shape, such as one that is augmented, so that the tunings are keyed by
+ *  the shape of the problem. Otherwise, it is the same as the overload that
+ *  keys by the shape of the input matrix.
+ *
+ *  @param key
+ *    Tuning key, which must be the same across MPI processes. See @link
+ *    CreateTuningKey @endlink.
+ */
+template <typename T>
+TuningParams TunedParams(
+    MPI_Comm mpi_comm,
+    const std::string &tuning_path,
+    const TuningKey &key,
+    JacobiSidedness sidedness,
+    const Mat<T> &input,
+    typename Actuator<T>::BatchInquiryFn batch_inquiry_fn,
+    std::function<real_t(size_t, real_t, size_t)> relax_fn,
+    const ActuatorOptions &options,
+    const TuningGrid &grid,
+    size_t trial_sweeps = 3,
+    real_t trial_tol = 1.0e-2);
+
+} // namespace grs
+} // namespace parallel
+} // namespace tanuki
+
+#include "tanuki/parallel/grs/autotuner.hxx"
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef TANUKI_PARALLEL_GRS_AUTOTUNER_HXX
+#define TANUKI_PARALLEL_GRS_AUTOTUNER_HXX
+
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+#include <omp.h>
+
+#include "tanuki/parallel/grs/convergence_criterion.h"
+
+namespace tanuki {
+namespace parallel {
+namespace grs {
+
+template <typename T>
+TuningParams Autotune(
+    MPI_Comm mpi_comm,
+    JacobiSidedness sidedness,
+    const Mat<T> &input,
+    typename Actuator<T>::BatchInquiryFn batch_inquiry_fn,
+    std::function<real_t(size_t, real_t, size_t)> relax_fn,
+    const ActuatorOptions &options,
+    const TuningGrid &grid,
+    size_t trial_sweeps,
+    real_t trial_tol) {
+  assert(trial_sweeps > 0);
+  assert(trial_tol > 0.0);
+
+  // Options of the trials, which converge by the rotations and are not
+  // checkpointed.
+  ActuatorOptions trial_options = options;
+  trial_options.convergence_criterion = ConvergenceCriterion::ROTATIONS;
+  trial_options.convergence_tol = trial_tol;
+  trial_options.skip_threshold = std::fmin(options.skip_threshold, trial_tol);
+  trial_options.checkpoint_path.clear();
+
+  // Maximum number of threads that is common to all MPI processes, so that
+  // they skip the same configurations and construct each actuator, which is
+  // collective, together.
+  int common_max_threads = omp_get_max_threads();
+
+  MPI_Allreduce(
+      MPI_IN_PLACE, &common_max_threads, 1, MPI_INT, MPI_MIN, mpi_comm);
+
+  bool has_best = false;
+  TuningParams best_params;
+  bool best_has_converged = false;
+  double best_elapsed = 0.0;
+  real_t best_max_abs_sine = 0.0;
+
+  for (const auto num_groups : grid.num_groups) {
+    for (const auto max_threads : grid.max_threads) {
+      for (const auto init_relax : grid.init_relaxes) {
+        if (num_groups == 0 ||
+            max_threads == 0 ||
+            max_threads > static_cast<size_t>(common_max_threads)) {
+          continue;
+        }
+
+        Actuator<T> actuator(
+            mpi_comm,
+            max_threads,
+            sidedness,
+            init_relax,
+            num_groups,
+            trial_sweeps,
+            relax_fn,
+            [](const Mat<T> &, const Mat<T> &) -> bool { return false; },
+            trial_options);
+
+        MPI_Barrier(mpi_comm);
+        const double start_time = MPI_Wtime();
+
+        const auto result = actuator.Actuate(input, batch_inquiry_fn);
+
+        // Wall time of the slowest MPI process.
+        double elapsed = MPI_Wtime() - start_time;
+
+        MPI_Allreduce(
+            MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, mpi_comm);
+
+        const bool is_better = !has_best ||
+            (result.has_converged && !best_has_converged) ||
+            (result.has_converged && elapsed < best_elapsed) ||
+            (!result.has_converged && !best_has_converged &&
+                 result.max_abs_sine < best_max_abs_sine);
+
+        if (is_better) {
+          has_best = true;
+
+          best_params = {
+            .num_groups = num_groups,
+            .max_threads = max_threads,
+            .init_relax = init_relax
+          };
+
+          best_has_converged = result.has_converged;
+          best_elapsed = elapsed;
+          best_max_abs_sine = result.max_abs_sine;
+        }
+      }
+    }
+  }
+
+  if (!has_best) {
+    throw std::invalid_argument("Tuning grid has no valid configuration.");
+  }
+
+  return best_params;
+}
+
+template <typename T>
+TuningParams TunedParams(
+    MPI_Comm mpi_comm,
+    const std::string &tuning_path,
+    JacobiSidedness sidedness,
+    const Mat<T> &input,
+    typename Actuator<T>::BatchInquiryFn batch_inquiry_fn,
+    std::function<real_t(size_t, real_t, size_t)> relax_fn,
+    const ActuatorOptions &options,
+    const TuningGrid &grid,
+    size_t trial_sweeps,
+    real_t trial_tol) {
+  return TunedParams(
+      mpi_comm, tuning_path,
+      CreateTuningKey(mpi_comm, input.n_rows, input.n_cols),
+      sidedness, input, batch_inquiry_fn, relax_fn, options, grid,
+      trial_sweeps, trial_tol);
+}
+
+template <typename T>
+TuningParams TunedParams(
+    MPI_Comm mpi_comm,
+    const std::string &tuning_path,
+    const TuningKey &key,
+    JacobiSidedness sidedness,
+    const Mat<T> &input,
+    typename Actuator<T>::BatchInquiryFn batch_inquiry_fn,
+    std::function<real_t(size_t, real_t, size_t)> relax_fn,
+    const ActuatorOptions &options,
+    const TuningGrid &grid,
+    size_t trial_sweeps,
+    real_t trial_tol) {
+  int mpi_rank;
+  MPI_Comm_rank(mpi_comm, &mpi_rank);
+
+  // Tuning file, which is accessed only at rank zero.
+  std::unique_ptr<TuningFile> tuning_file;
+
+  // Parameters as the number of groups, the maximum number of threads, and
+  // the initial relaxation parameter for broadcasting, followed by whether
+  // they were found.
+  real_t packed_params[4] = {0.0, 0.0, 0.0, 0.0};
+
+  if (mpi_rank == 0) {
+    tuning_file.reset(new TuningFile(tuning_path));
+
+    if (tuning_file->Contains(key)) {
+      const auto &params = tuning_file->At(key);
+
+      packed_params[0] = params.num_groups;
+      packed_params[1] = params.max_threads;
+      packed_params[2] = params.init_relax;
+      packed_params[3] = 1.0;
+    }
+  }
+
+  MPI_Bcast(packed_params, 4, MPI_DOUBLE, 0, mpi_comm);
+
+  if (packed_params[3] != 0.0) {
+    return {
+      .num_groups = static_cast<size_t>(packed_params[0]),
+      .max_threads = static_cast<size_t>(packed_params[1]),
+      .init_relax = packed_params[2]
+    };
+  }
+
+  const auto retval = Autotune(
+      mpi_comm, sidedness, input, batch_inquiry_fn, relax_fn, options, grid,
+      trial_sweeps, trial_tol);
+
+  if (mpi_rank == 0) {
+    tuning_file->Store(key, retval);
+  }
+
+  return retval;
+}
+
+} // namespace grs
+} // namespace parallel
+} // namespace tanuki
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef TANUKI_PARALLEL_GRS_CHECKPOINT_H
+#define TANUKI_PARALLEL_GRS_CHECKPOINT_H
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+#include <armadillo>
+#include <avro/Decoder.hh>
+#include <avro/Encoder.hh>
+#include <avro/Specific.hh>
+
+#include "tanuki/avro_specific/armadillo.h"
+#include "tanuki/avro_specific/size_t.h"
+#include "tanuki/number/types.h"
+
+namespace tanuki {
+namespace parallel {
+namespace grs {
+
+using arma::Mat;
+
+using tanuki::number::complex_t;
+using tanuki::number::real_t;
+
+/**
+ *  @brief State of a GRS actuation at the end of an iteration.
+ *
+ *  @tparam T
+ *    Type of elements in an Armadillo matrix.
+ */
+template <typename T>
+struct Checkpoint final {
+ public:
+  /**
+   *  @brief Current matrix.
+   */
+  Mat<T> matrix;
+
+  /**
+   *  @brief Accumulated rotation, or an empty matrix if it is not
+   *  accumulated.
+   */
+  Mat<T> rotation;
+
+  /**
+   *  @brief Number of iterations that have been performed.
+   */
+  size_t num_iters;
+
+  /**
+   *  @brief Relaxation parameter of the first group of the next iteration.
+   */
+  real_t relaxation;
+
+  /**
+   *  @brief Threshold of rotation angles of the next iteration.
+   */
+  real_t skip_threshold;
+
+  /**
+   *  @brief Maximum magnitude of the sines of the unrelaxed rotations in the
+   *  last iteration.
+   */
+  real_t max_abs_sine;
+
+  /**
+   *  @brief Sum of the squares of the sines of the unrelaxed rotations in the
+   *  last iteration.
+   */
+  real_t sum_sq_sines;
+};
+
+/**
+ *  @brief Writes a checkpoint to a file with the Avro binary encoding.
+ *
+ *  Checkpoint is written to a temporary file next to the file and then
+ *  renamed, so that the file is either the previous or the new checkpoint if
+ *  the writing is interrupted. If the file cannot be written,
+ *  <tt>std::runtime_error</tt> is thrown.
+ */
+template <typename T>
+void WriteCheckpoint(const std::string &path, const Checkpoint<T> &checkpoint);
+
+/**
+ *  @brief Reads a checkpoint from a file written by @link WriteCheckpoint
+ *  @endlink.
+ *
+ *  @return
+ *    Whether the file exists. If it does not, <tt>checkpoint</tt> is not
+ *    modified.
+ */
+template <typename T>
+bool ReadCheckpoint(const std::string &path, Checkpoint<T> &checkpoint);
+
+} // namespace grs
+} // namespace parallel
+} // namespace tanuki
+
+namespace avro {
+
+using tanuki::parallel::grs::Checkpoint;
+
+/**
+ *  @brief Encoding and decoding of @link Checkpoint @endlink.
+ *
+ *  Members are encoded in the order of declaration. Matrices are encoded as
+ *  <tt>tanuki.math.linear.NumberArray</tt> in the precision of @link
+ *  tanuki::number::real_t @endlink.
+ */
+template <typename T>
+struct codec_traits<Checkpoint<T>> {
+ public:
+  static void encode(Encoder &e, const Checkpoint<T> &o) {
+    avro::encode(e, arma::conv_to<Mat<stored_t>>::from(o.matrix));
+    avro::encode(e, arma::conv_to<Mat<stored_t>>::from(o.rotation));
+    avro::encode(e, o.num_iters);
+    avro::encode(e, o.relaxation);
+    avro::encode(e, o.skip_threshold);
+    avro::encode(e, o.max_abs_sine);
+    avro::encode(e, o.sum_sq_sines);
+  }
+
+  static void decode(Decoder &d, Checkpoint<T> &o) {
+    Mat<stored_t> matrix;
+    Mat<stored_t> rotation;
+
+    avro::decode(d, matrix);
+    avro::decode(d, rotation);
+
+    o.matrix = arma::conv_to<Mat<T>>::from(matrix);
+    o.rotation = arma::conv_to<Mat<T>>::from(rotation);
+
+    avro::decode(d, o.num_iters);
+    avro::decode(d, o.relaxation);
+    avro::decode(d, o.skip_threshold);
+    avro::decode(d, o.max_abs_sine);
+    avro::decode(d, o.sum_sq_sines);
+  }
+
+ private:
+  /**
+   *  @brief Type of the encoded matrix elements, which is @link
+   *  tanuki::number::real_t @endlink or @link tanuki::number::complex_t
+   *  @endlink.
+   */
+  using stored_t = typename std::conditional<
+      std::is_same<T, typename arma::get_pod_type<T>::result>::value,
+      tanuki::number::real_t,
+      tanuki::number::complex_t>::type;
+};
+
+} // namespace avro
+
+#include "tanuki/parallel/grs/checkpoint.hxx"
+
+#endif
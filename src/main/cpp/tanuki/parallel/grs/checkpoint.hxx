@@ -0,0 +1,54 @@
+#ifndef TANUKI_PARALLEL_GRS_CHECKPOINT_HXX
+#define TANUKI_PARALLEL_GRS_CHECKPOINT_HXX
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include <avro/Stream.hh>
+
+namespace tanuki {
+namespace parallel {
+namespace grs {
+
+template <typename T>
+void WriteCheckpoint(
+    const std::string &path, const Checkpoint<T> &checkpoint) {
+  const std::string tmp_path = path + ".tmp";
+
+  {
+    auto out = avro::fileOutputStream(tmp_path.c_str());
+
+    avro::EncoderPtr e = avro::binaryEncoder();
+    e->init(*out);
+
+    avro::encode(*e, checkpoint);
+    e->flush();
+  }
+
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    throw std::runtime_error("Checkpoint cannot be written: " + path);
+  }
+}
+
+template <typename T>
+bool ReadCheckpoint(const std::string &path, Checkpoint<T> &checkpoint) {
+  if (!std::ifstream(path)) {
+    return false;
+  }
+
+  auto in = avro::fileInputStream(path.c_str());
+
+  avro::DecoderPtr d = avro::binaryDecoder();
+  d->init(*in);
+
+  avro::decode(*d, checkpoint);
+
+  return true;
+}
+
+} // namespace grs
+} // namespace parallel
+} // namespace tanuki
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef TANUKI_PARALLEL_GRS_CONVERGENCE_CRITERION_H
+#define TANUKI_PARALLEL_GRS_CONVERGENCE_CRITERION_H
+
+namespace tanuki {
+namespace parallel {
+namespace grs {
+
+/**
+ *  @brief Criterion of convergence of GRS at the end of each iteration.
+ */
+enum class ConvergenceCriterion : int {
+  /**
+   *  @brief Convergence checker is invoked on the previous and current
+   *  matrices at each MPI process.
+   */
+  MATRICES,
+
+  /**
+   *  @brief Maximum magnitude of the sines of the unrelaxed rotations in the
+   *  iteration does not exceed the tolerance.
+   *
+   *  Statistics are gathered while the rotations are computed, so the
+   *  previous matrix is neither kept nor compared.
+   */
+  ROTATIONS,
+
+  /**
+   *  @brief Frobenius norm of the change of the matrix in the iteration
+   *  relative to that of the current matrix does not exceed the tolerance.
+   *
+   *  Norms are evaluated over columns that are distributed across the MPI
+   *  processes at each host.
+   */
+  FROBENIUS
+};
+
+} // namespace grs
+} // namespace parallel
+} // namespace tanuki
+
+#endif
@@ -17,7 +17,12 @@ enum class JacobiSidedness : int {
   /**
    *  @brief Two-sided GRS.
    */
-  TWO_SIDED
+  TWO_SIDED,
+
+  /**
+   *  @brief One-sided GRS with the rows being rotated.
+   */
+  ONE_SIDED_LEFT
 };
 
 } // namespace grs
@@ -0,0 +1,435 @@
+#include "tanuki/parallel/grs/pair_ordering.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <omp.h>
+
+#include "tanuki/common/divider/group_delimiter.h"
+
+namespace tanuki {
+namespace parallel {
+namespace grs {
+
+using std::vector;
+
+using arma::Mat;
+
+using common::divider::GroupIndices;
+
+void RoundRobinOrdering::Reset(size_t num_vectors) {
+  assert(num_vectors >= 2);
+
+  tourney_.reset(new Tourney(num_vectors));
+  round_it_.reset(new Tourney::Iterator(tourney_->begin()));
+}
+
+size_t RoundRobinOrdering::num_rotation_sets() const {
+  assert(tourney_);
+
+  return tourney_->num_rounds();
+}
+
+bool RoundRobinOrdering::is_static() const {
+  return true;
+}
+
+Mat<long long> RoundRobinOrdering::NextRotationSet() {
+  assert(tourney_);
+
+  if (*round_it_ == tourney_->end()) {
+    *round_it_ = tourney_->begin();
+  }
+
+  Mat<long long> retval((*round_it_)->t());
+  ++(*round_it_);
+
+  return retval;
+}
+
+void RoundRobinOrdering::Update(
+    const Mat<long long> &rotation_pairs,
+    const Mat<real_t> &cosine_sine) {
+}
+
+void GreedyOrdering::Reset(size_t num_vectors) {
+  assert(num_vectors >= 2);
+
+  const real_t infinity = std::numeric_limits<real_t>::infinity();
+
+  importance_.set_size(num_vectors, num_vectors);
+  importance_.fill(infinity);
+
+  partners_.assign(num_vectors, PartnerSet());
+
+  // Concurrently order the partners of the vectors, which are all infinitely
+  // important and are therefore in the order of their indices.
+  #pragma omp parallel default(shared)
+  {
+    const auto vector_chunks =
+        GroupIndices(0, num_vectors, omp_get_num_threads());
+
+    const auto thread_num = omp_get_thread_num();
+
+    for (size_t j = vector_chunks[thread_num];
+         j != vector_chunks[thread_num + 1];
+         ++j) {
+      auto &partners = partners_[j];
+
+      for (size_t i = 0; i != num_vectors; ++i) {
+        if (i != j) {
+          partners.emplace_hint(partners.end(), -infinity, i);
+        }
+      }
+    }
+  }
+}
+
+size_t GreedyOrdering::num_rotation_sets() const {
+  const size_t num_vectors = importance_.n_cols;
+
+  return num_vectors & 1 ? num_vectors : num_vectors - 1;
+}
+
+bool GreedyOrdering::is_static() const {
+  return false;
+}
+
+Mat<long long> GreedyOrdering::NextRotationSet() {
+  const size_t num_vectors = importance_.n_cols;
+
+  assert(num_vectors >= 2);
+  assert(partners_.size() == num_vectors);
+
+  // Importance of the most important eligible pair of each vector.
+  vector<real_t> max_importance(num_vectors, -1.0);
+
+  for (size_t j = 0; j != num_vectors; ++j) {
+    if (!partners_[j].empty()) {
+      max_importance[j] = -partners_[j].begin()->first;
+    }
+  }
+
+  // Vector indices in descending order of their most important pairs.
+  vector<size_t> order(num_vectors);
+  std::iota(order.begin(), order.end(), 0);
+
+  std::stable_sort(
+      order.begin(), order.end(),
+      [&max_importance](size_t a, size_t b) -> bool {
+        return max_importance[a] > max_importance[b];
+      });
+
+  vector<bool> is_matched(num_vectors, false);
+
+  Mat<long long> retval(2, (num_vectors + 1) / 2);
+  retval.fill(-1);
+
+  size_t num_pairs = 0;
+
+  for (const auto j : order) {
+    if (is_matched[j]) {
+      continue;
+    }
+
+    // Most important unmatched partner that is not in the current group.
+    const auto partner_it = std::find_if(
+        partners_[j].begin(), partners_[j].end(),
+        [&is_matched](const std::pair<real_t, size_t> &partner) -> bool {
+          return !is_matched[partner.second];
+        });
+
+    if (partner_it == partners_[j].end()) {
+      continue;
+    }
+
+    const size_t partner = partner_it->second;
+
+    is_matched[j] = true;
+    is_matched[partner] = true;
+
+    // Mark the pair as being in the current group.
+    SetImportance(j, partner, -1.0);
+
+    retval(0, num_pairs) = std::min(j, partner);
+    retval(1, num_pairs) = std::max(j, partner);
+
+    ++num_pairs;
+  }
+
+  return retval;
+}
+
+void GreedyOrdering::Update(
+    const Mat<long long> &rotation_pairs,
+    const Mat<real_t> &cosine_sine) {
+  assert(rotation_pairs.n_rows == 2);
+  assert(cosine_sine.n_cols == rotation_pairs.n_cols);
+
+  for (size_t rp = 0; rp != rotation_pairs.n_cols; ++rp) {
+    const auto first = rotation_pairs(0, rp);
+    const auto second = rotation_pairs(1, rp);
+
+    if (first == -1 || second == -1) {
+      continue;
+    }
+
+    SetImportance(
+        first,
+        second,
+        std::abs(std::atan2(cosine_sine(1, rp), cosine_sine(0, rp))));
+  }
+}
+
+void GreedyOrdering::SetImportance(
+    size_t first, size_t second, real_t importance) {
+  assert(first != second);
+
+  const real_t prev_importance = importance_(first, second);
+
+  if (prev_importance >= 0.0) {
+    partners_[first].erase(std::make_pair(-prev_importance, second));
+    partners_[second].erase(std::make_pair(-prev_importance, first));
+  }
+
+  importance_(first, second) = importance;
+  importance_(second, first) = importance;
+
+  if (importance >= 0.0) {
+    partners_[first].emplace(-importance, second);
+    partners_[second].emplace(-importance, first);
+  }
+}
+
+ActiveSetOrdering::ActiveSetOrdering(const vector<bool> &is_active)
+    : is_active_(is_active) {
+}
+
+void ActiveSetOrdering::Reset(size_t num_vectors) {
+  assert(num_vectors >= 2);
+  assert(num_vectors == is_active_.size());
+
+  vector<long long> actives;
+  vector<long long> inactives;
+
+  for (size_t i = 0; i != num_vectors; ++i) {
+    (is_active_[i] ? actives : inactives).push_back(i);
+  }
+
+  rotation_sets_.clear();
+  next_rs_ = 0;
+
+  // Rotation sets of the pairs of active vectors.
+  if (actives.size() >= 2) {
+    const math::combinatorics::RoundRobinTourney<long long> tourney(
+        actives.size());
+
+    for (auto round_it = tourney.begin();
+         round_it != tourney.end();
+         ++round_it) {
+      const auto &round = *round_it;
+
+      Mat<long long> rotation_set(2, actives.size() / 2);
+
+      // Number of pairs in the rotation set without the idle pair.
+      size_t num_pairs = 0;
+
+      for (size_t p = 0; p != round.n_rows; ++p) {
+        if (round(p, 0) == -1 || round(p, 1) == -1) {
+          continue;
+        }
+
+        rotation_set(0, num_pairs) = actives[round(p, 0)];
+        rotation_set(1, num_pairs) = actives[round(p, 1)];
+
+        ++num_pairs;
+      }
+
+      assert(num_pairs == rotation_set.n_cols);
+
+      rotation_sets_.push_back(std::move(rotation_set));
+    }
+  }
+
+  // Rotation sets of the pairs of an active and an inactive vector.
+  if (!actives.empty() && !inactives.empty()) {
+    const auto &smaller =
+        actives.size() <= inactives.size() ? actives : inactives;
+    const auto &larger =
+        actives.size() <= inactives.size() ? inactives : actives;
+
+    for (size_t shift = 0; shift != larger.size(); ++shift) {
+      Mat<long long> rotation_set(2, smaller.size());
+
+      for (size_t p = 0; p != smaller.size(); ++p) {
+        const auto first = smaller[p];
+        const auto second = larger[(p + shift) % larger.size()];
+
+        rotation_set(0, p) = std::min(first, second);
+        rotation_set(1, p) = std::max(first, second);
+      }
+
+      rotation_sets_.push_back(std::move(rotation_set));
+    }
+  }
+
+  // Rotation set without pairs if there are no pairs to rotate.
+  if (rotation_sets_.empty()) {
+    rotation_sets_.emplace_back(2, 0);
+  }
+}
+
+size_t ActiveSetOrdering::num_rotation_sets() const {
+  return rotation_sets_.size();
+}
+
+bool ActiveSetOrdering::is_static() const {
+  return true;
+}
+
+Mat<long long> ActiveSetOrdering::NextRotationSet() {
+  assert(!rotation_sets_.empty());
+
+  if (next_rs_ == rotation_sets_.size()) {
+    next_rs_ = 0;
+  }
+
+  return rotation_sets_[next_rs_++];
+}
+
+void ActiveSetOrdering::Update(
+    const Mat<long long> &rotation_pairs,
+    const Mat<real_t> &cosine_sine) {
+}
+
+MultiProblemOrdering::MultiProblemOrdering(
+    const vector<size_t> &num_problem_vectors,
+    const vector<std::shared_ptr<PairOrdering>> &orderings)
+        : offsets_(1, 0), orderings_(orderings) {
+  assert(!num_problem_vectors.empty());
+  assert(orderings_.empty() ||
+         orderings_.size() == num_problem_vectors.size());
+
+  orderings_.resize(num_problem_vectors.size());
+
+  for (size_t p = 0; p != num_problem_vectors.size(); ++p) {
+    assert(num_problem_vectors[p] >= 2);
+
+    offsets_.push_back(offsets_.back() + num_problem_vectors[p]);
+
+    if (!orderings_[p]) {
+      orderings_[p].reset(new RoundRobinOrdering());
+    }
+  }
+}
+
+void MultiProblemOrdering::Reset(size_t num_vectors) {
+  assert(num_vectors == offsets_.back());
+
+  for (size_t p = 0; p != orderings_.size(); ++p) {
+    orderings_[p]->Reset(offsets_[p + 1] - offsets_[p]);
+  }
+
+  next_rs_ = 0;
+}
+
+size_t MultiProblemOrdering::num_rotation_sets() const {
+  size_t retval = 0;
+
+  for (const auto &ordering : orderings_) {
+    retval = std::max(retval, ordering->num_rotation_sets());
+  }
+
+  return retval;
+}
+
+bool MultiProblemOrdering::is_static() const {
+  return std::all_of(
+      orderings_.begin(), orderings_.end(),
+      [](const std::shared_ptr<PairOrdering> &ordering) -> bool {
+        return ordering->is_static();
+      });
+}
+
+Mat<long long> MultiProblemOrdering::NextRotationSet() {
+  if (next_rs_ == num_rotation_sets()) {
+    next_rs_ = 0;
+  }
+
+  // Number of non-idle pairs in a rotation set of each problem does not
+  // exceed half its number of vectors rounded down, so the non-idle pairs of
+  // all problems fit in a rotation set of the concatenated vectors.
+  Mat<long long> retval(2, (offsets_.back() + 1) / 2);
+  retval.fill(-1);
+
+  size_t num_pairs = 0;
+
+  for (size_t p = 0; p != orderings_.size(); ++p) {
+    if (next_rs_ >= orderings_[p]->num_rotation_sets()) {
+      continue;
+    }
+
+    const auto rotation_set = orderings_[p]->NextRotationSet();
+
+    for (size_t rp = 0; rp != rotation_set.n_cols; ++rp) {
+      if (rotation_set(0, rp) == -1 || rotation_set(1, rp) == -1) {
+        continue;
+      }
+
+      retval(0, num_pairs) = rotation_set(0, rp) + offsets_[p];
+      retval(1, num_pairs) = rotation_set(1, rp) + offsets_[p];
+
+      ++num_pairs;
+    }
+  }
+
+  ++next_rs_;
+
+  // Idle pairs are not exchanged or applied.
+  retval.resize(2, num_pairs);
+
+  return retval;
+}
+
+void MultiProblemOrdering::Update(
+    const Mat<long long> &rotation_pairs,
+    const Mat<real_t> &cosine_sine) {
+  assert(rotation_pairs.n_rows == 2);
+  assert(cosine_sine.n_cols == rotation_pairs.n_cols);
+
+  for (size_t p = 0; p != orderings_.size(); ++p) {
+    const long long first_vector = offsets_[p];
+    const long long last_vector = offsets_[p + 1];
+
+    // Positions of the non-idle pairs of the problem.
+    vector<arma::uword> positions;
+
+    for (size_t rp = 0; rp != rotation_pairs.n_cols; ++rp) {
+      if (rotation_pairs(0, rp) >= first_vector &&
+          rotation_pairs(0, rp) < last_vector &&
+          rotation_pairs(1, rp) >= first_vector &&
+          rotation_pairs(1, rp) < last_vector) {
+        positions.push_back(rp);
+      }
+    }
+
+    if (positions.empty()) {
+      continue;
+    }
+
+    const arma::uvec cols(positions);
+
+    orderings_[p]->Update(
+        rotation_pairs.cols(cols) - first_vector, cosine_sine.cols(cols));
+  }
+}
+
+} // namespace grs
+} // namespace parallel
+} // namespace tanuki
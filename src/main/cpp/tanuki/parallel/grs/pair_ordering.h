@@ -0,0 +1,307 @@
+#ifndef TANUKI_PARALLEL_GRS_PAIR_ORDERING_H
+#define TANUKI_PARALLEL_GRS_PAIR_ORDERING_H
+
+#include <cstddef>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <armadillo>
+
+#include "tanuki/math/combinatorics/round_robin_tourney.h"
+#include "tanuki/number/types.h"
+
+namespace tanuki {
+namespace parallel {
+namespace grs {
+
+using tanuki::number::real_t;
+
+/**
+ *  @brief Interface of a strategy that orders the vector pairs of GRS into
+ *  rotation sets.
+ *
+ *  Each rotation set is a two-row matrix of non-conflicting pairs of vector
+ *  indices, where each column is a pair. A pair with an index of <tt>-1</tt>
+ *  is idle. Number of pairs in each rotation set must not exceed half the
+ *  number of vectors rounded up, and it can differ between rotation sets.
+ *  Relaxed rotations of only the pairs in a rotation set are exchanged and
+ *  applied, so a rotation set with fewer pairs costs less.
+ */
+class PairOrdering {
+ public:
+  virtual ~PairOrdering() = default;
+
+  /**
+   *  @brief Resets the ordering for an actuation.
+   *
+   *  @param num_vectors
+   *    Number of vectors. It must be at least two.
+   */
+  virtual void Reset(size_t num_vectors) = 0;
+
+  /**
+   *  @brief Number of rotation sets in an iteration.
+   */
+  virtual size_t num_rotation_sets() const = 0;
+
+  /**
+   *  @brief Whether the same sequence of rotation sets is repeated in every
+   *  iteration.
+   */
+  virtual bool is_static() const = 0;
+
+  /**
+   *  @brief Creates the next rotation set.
+   *
+   *  Rotation sets created before the update of the rotations are in the
+   *  same group and must not have a pair in common.
+   */
+  virtual arma::Mat<long long> NextRotationSet() = 0;
+
+  /**
+   *  @brief Updates the ordering with the relaxed rotations of a group.
+   *
+   *  @param rotation_pairs
+   *    Concatenated rotation sets of the group.
+   *
+   *  @param cosine_sine
+   *    Cosines and sines of the relaxed rotations at the top and bottom rows,
+   *    respectively, corresponding by column to <tt>rotation_pairs</tt>.
+   */
+  virtual void Update(
+      const arma::Mat<long long> &rotation_pairs,
+      const arma::Mat<real_t> &cosine_sine) = 0;
+};
+
+/**
+ *  @brief Cyclic ordering by the rounds of a round-robin tournament.
+ *
+ *  It is the default ordering of GRS.
+ */
+class RoundRobinOrdering final : public PairOrdering {
+ public:
+  void Reset(size_t num_vectors) override;
+
+  size_t num_rotation_sets() const override;
+
+  bool is_static() const override;
+
+  arma::Mat<long long> NextRotationSet() override;
+
+  void Update(
+      const arma::Mat<long long> &rotation_pairs,
+      const arma::Mat<real_t> &cosine_sine) override;
+
+ private:
+  using Tourney = math::combinatorics::RoundRobinTourney<long long>;
+
+  /**
+   *  @brief Round-robin tournament of the vector indices.
+   */
+  std::unique_ptr<Tourney> tourney_;
+
+  /**
+   *  @brief Iterator to the next round.
+   */
+  std::unique_ptr<Tourney::Iterator> round_it_;
+};
+
+/**
+ *  @brief Dynamic ordering by greedy maximum-weight matching on the
+ *  importance of the pairs.
+ *
+ *  Importance of a pair is the magnitude of the angle of its most recent
+ *  relaxed rotation, and it is infinite for a pair that has not been rotated
+ *  in the actuation. Each rotation set is built by visiting the vectors in
+ *  descending order of their most important pairs and matching each unmatched
+ *  vector with its most important unmatched partner, so that the largest
+ *  corrections are made first (de Rijk 1989). Pairs that are already in the
+ *  current group are not matched again until the update.
+ *
+ *  Importance is kept as a dense matrix whose size is the square of the
+ *  number of vectors, and the eligible partners of each vector are kept in
+ *  descending order of importance. Building a rotation set of \f$ n \f$
+ *  vectors therefore takes \f$ O(n \log n) \f$ time besides skipping the
+ *  partners that are already matched in the set, instead of \f$ O(n^2) \f$,
+ *  and updating a pair takes \f$ O(\log n) \f$ time. Partners of the vectors
+ *  are ordered concurrently by threads when the ordering is reset.
+ */
+class GreedyOrdering final : public PairOrdering {
+ public:
+  void Reset(size_t num_vectors) override;
+
+  size_t num_rotation_sets() const override;
+
+  bool is_static() const override;
+
+  arma::Mat<long long> NextRotationSet() override;
+
+  void Update(
+      const arma::Mat<long long> &rotation_pairs,
+      const arma::Mat<real_t> &cosine_sine) override;
+
+ private:
+  /**
+   *  @brief Eligible partners of a vector as negated importances paired with
+   *  the partner indices, so that the most important partner (with the
+   *  lowest index among ties) is the first.
+   */
+  using PartnerSet = std::set<std::pair<real_t, size_t>>;
+
+  /**
+   *  @brief Sets the importance of a pair and keeps the partners of its
+   *  vectors in order.
+   *
+   *  @param importance
+   *    Importance of the pair, or a negative value if the pair is not
+   *    eligible.
+   */
+  void SetImportance(size_t first, size_t second, real_t importance);
+
+  /**
+   *  @brief Importance of each pair, where a negative value indicates that
+   *  the pair is in the current group.
+   */
+  arma::Mat<real_t> importance_;
+
+  /**
+   *  @brief Eligible partners of each vector in descending order of
+   *  importance.
+   */
+  std::vector<PartnerSet> partners_;
+};
+
+/**
+ *  @brief Static ordering of only the pairs that include at least one active
+ *  vector.
+ *
+ *  Pairs of two inactive vectors are never scheduled, which is valid if their
+ *  rotations are known to be identities. Each iteration consists of the
+ *  rounds of a round-robin tournament of the active vectors followed by the
+ *  rounds of the pairs of an active with an inactive vector, where each
+ *  vector of the smaller set is paired with a cyclically shifted vector of
+ *  the larger set. Number of rotation sets in an iteration is therefore
+ *  linear in the number of vectors only if there are inactive vectors, and
+ *  the number of pairs is linear in the number of active vectors.
+ *
+ *  Each rotation set has only its pairs without idle pairs, so a rotation
+ *  set of an active with an inactive vector has as many pairs as the
+ *  smaller of the two sets of vectors. With few active vectors, the
+ *  rotations exchanged and applied in an iteration are therefore far fewer
+ *  than those of all pairs, even though the number of rotation sets is
+ *  about the same.
+ */
+class ActiveSetOrdering final : public PairOrdering {
+ public:
+  /**
+   *  @param is_active
+   *    Whether each vector is active.
+   */
+  explicit ActiveSetOrdering(const std::vector<bool> &is_active);
+
+  /**
+   *  @param num_vectors
+   *    Number of vectors, which must be the same as the number of elements in
+   *    the flags of activity.
+   */
+  void Reset(size_t num_vectors) override;
+
+  size_t num_rotation_sets() const override;
+
+  bool is_static() const override;
+
+  arma::Mat<long long> NextRotationSet() override;
+
+  void Update(
+      const arma::Mat<long long> &rotation_pairs,
+      const arma::Mat<real_t> &cosine_sine) override;
+
+ private:
+  /**
+   *  @brief Whether each vector is active.
+   */
+  const std::vector<bool> is_active_;
+
+  /**
+   *  @brief Rotation sets of an iteration.
+   */
+  std::vector<arma::Mat<long long>> rotation_sets_;
+
+  /**
+   *  @brief Index of the next rotation set.
+   */
+  size_t next_rs_ = 0;
+};
+
+/**
+ *  @brief Ordering of the vector pairs of several independent problems whose
+ *  vectors are concatenated.
+ *
+ *  Vectors of each problem are consecutive, and the problems are in order.
+ *  Each rotation set is the union of the next rotation sets of the problems,
+ *  whose indices are offset by the first vector of each problem, so that the
+ *  problems are interleaved within the same rotation sets and no pair spans
+ *  two problems. A problem whose rotation sets in an iteration are exhausted
+ *  is idle for the rest of the iteration.
+ */
+class MultiProblemOrdering final : public PairOrdering {
+ public:
+  /**
+   *  @param num_problem_vectors
+   *    Number of vectors of each problem. Each must be at least two.
+   *
+   *  @param orderings
+   *    Ordering of each problem, or null for @link RoundRobinOrdering
+   *    @endlink. If empty, every problem is ordered by @link
+   *    RoundRobinOrdering @endlink.
+   */
+  MultiProblemOrdering(
+      const std::vector<size_t> &num_problem_vectors,
+      const std::vector<std::shared_ptr<PairOrdering>> &orderings =
+          std::vector<std::shared_ptr<PairOrdering>>());
+
+  /**
+   *  @param num_vectors
+   *    Number of vectors, which must be the total number of vectors of the
+   *    problems.
+   */
+  void Reset(size_t num_vectors) override;
+
+  size_t num_rotation_sets() const override;
+
+  bool is_static() const override;
+
+  arma::Mat<long long> NextRotationSet() override;
+
+  /**
+   *  @brief Updates the ordering of each problem with its relaxed rotations.
+   */
+  void Update(
+      const arma::Mat<long long> &rotation_pairs,
+      const arma::Mat<real_t> &cosine_sine) override;
+
+ private:
+  /**
+   *  @brief Index of the first vector of each problem, followed by the total
+   *  number of vectors.
+   */
+  std::vector<size_t> offsets_;
+
+  /**
+   *  @brief Ordering of each problem.
+   */
+  std::vector<std::shared_ptr<PairOrdering>> orderings_;
+
+  /**
+   *  @brief Index of the next rotation set in an iteration.
+   */
+  size_t next_rs_ = 0;
+};
+
+} // namespace grs
+} // namespace parallel
+} // namespace tanuki
+
+#endif
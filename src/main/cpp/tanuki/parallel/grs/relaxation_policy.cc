@@ -0,0 +1,59 @@
+#include "tanuki/parallel/grs/relaxation_policy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace tanuki {
+namespace parallel {
+namespace grs {
+
+AdaptiveRelaxation::AdaptiveRelaxation(
+    real_t decrease_factor,
+    real_t increase_fraction)
+        : decrease_factor_(decrease_factor),
+          increase_fraction_(increase_fraction) {
+  if (decrease_factor_ <= 0.0 || decrease_factor_ > 1.0) {
+    throw std::domain_error(
+        "Decrease factor of relaxation is not in the interval (0, 1].");
+  }
+
+  if (increase_fraction_ < 0.0 || increase_fraction_ > 1.0) {
+    throw std::domain_error(
+        "Increase fraction of relaxation is not in the interval [0, 1].");
+  }
+}
+
+void AdaptiveRelaxation::Reset(size_t num_groups, real_t init_relax) {
+  assert(num_groups > 0);
+  assert(init_relax >= 0.0 && init_relax < 1.0);
+
+  ceiling_ = init_relax;
+  prev_sums_sq_sines_.assign(num_groups, 0.0);
+}
+
+real_t AdaptiveRelaxation::NextRelaxation(
+    size_t iter,
+    size_t group,
+    real_t prev_relax,
+    real_t sum_sq_sines) {
+  assert(group < prev_sums_sq_sines_.size());
+
+  // Whether the progress measure of the group did not decrease.
+  const bool is_oscillating =
+      iter > 0 && sum_sq_sines >= prev_sums_sq_sines_[group];
+
+  prev_sums_sq_sines_[group] = sum_sq_sines;
+
+  if (is_oscillating) {
+    return std::min(
+        ceiling_,
+        prev_relax + increase_fraction_ * (ceiling_ - prev_relax));
+  } else {
+    return prev_relax * decrease_factor_;
+  }
+}
+
+} // namespace grs
+} // namespace parallel
+} // namespace tanuki
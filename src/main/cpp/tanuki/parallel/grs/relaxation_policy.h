@@ -0,0 +1,127 @@
+#ifndef TANUKI_PARALLEL_GRS_RELAXATION_POLICY_H
+#define TANUKI_PARALLEL_GRS_RELAXATION_POLICY_H
+
+#include <cstddef>
+#include <vector>
+
+#include "tanuki/number/types.h"
+
+namespace tanuki {
+namespace parallel {
+namespace grs {
+
+using tanuki::number::real_t;
+
+/**
+ *  @brief Interface of a policy that determines the relaxation parameter of
+ *  GRS from the progress of the actuation.
+ *
+ *  Progress is measured after each group of rotation sets as the sum of the
+ *  squares of the sines of the unrelaxed rotations in the group, which
+ *  vanishes at convergence.
+ */
+class RelaxationPolicy {
+ public:
+  virtual ~RelaxationPolicy() = default;
+
+  /**
+   *  @brief Resets the policy for an actuation.
+   *
+   *  @param num_groups
+   *    Number of groups of rotation sets in an iteration.
+   *
+   *  @param init_relax
+   *    Initial relaxation parameter of the actuation.
+   */
+  virtual void Reset(size_t num_groups, real_t init_relax) = 0;
+
+  /**
+   *  @brief Relaxation parameter to use for the next group of rotation sets.
+   *
+   *  @param iter
+   *    Index of the iteration.
+   *
+   *  @param group
+   *    Index of the group that has just been applied.
+   *
+   *  @param prev_relax
+   *    Relaxation parameter of the group that has just been applied.
+   *
+   *  @param sum_sq_sines
+   *    Sum of the squares of the sines of the unrelaxed rotations in the
+   *    group.
+   *
+   *  @return
+   *    Relaxation parameter in the range \f$ [0, 1) \f$.
+   */
+  virtual real_t NextRelaxation(
+      size_t iter, size_t group, real_t prev_relax, real_t sum_sq_sines) = 0;
+};
+
+/**
+ *  @brief Relaxation that adapts to the change of the progress measure of each
+ *  group from the previous iteration.
+ *
+ *  If the measure of a group decreased, the rotations are making monotone
+ *  progress, and the relaxation parameter is decreased by a factor toward
+ *  unrelaxed rotations. Otherwise, the rotations are oscillating, and the
+ *  relaxation parameter is increased by a fraction of its distance to the
+ *  initial relaxation parameter, which is the ceiling. The initial relaxation
+ *  parameter is therefore intended to be a recommendation such as that of
+ *  @link GrsOneSidedRelaxParam @endlink or @link GrsTwoSidedRelaxParam
+ *  @endlink. In the first iteration, the relaxation parameter is decreased.
+ */
+class AdaptiveRelaxation final : public RelaxationPolicy {
+ public:
+  /**
+   *  @param decrease_factor
+   *    Factor in the interval \f$ (0, 1] \f$ by which the relaxation
+   *    parameter is multiplied on progress. Otherwise,
+   *    <tt>std::domain_error</tt> is thrown.
+   *
+   *  @param increase_fraction
+   *    Fraction in the interval \f$ [0, 1] \f$ of the distance to the ceiling
+   *    by which the relaxation parameter is increased on oscillation.
+   *    Otherwise, <tt>std::domain_error</tt> is thrown.
+   */
+  AdaptiveRelaxation(
+      real_t decrease_factor = 0.5,
+      real_t increase_fraction = 0.5);
+
+  void Reset(size_t num_groups, real_t init_relax) override;
+
+  real_t NextRelaxation(
+      size_t iter,
+      size_t group,
+      real_t prev_relax,
+      real_t sum_sq_sines) override;
+
+ private:
+  /**
+   *  @brief Factor by which the relaxation parameter is multiplied on
+   *  progress.
+   */
+  const real_t decrease_factor_;
+
+  /**
+   *  @brief Fraction of the distance to the ceiling by which the relaxation
+   *  parameter is increased on oscillation.
+   */
+  const real_t increase_fraction_;
+
+  /**
+   *  @brief Ceiling of the relaxation parameter.
+   */
+  real_t ceiling_ = 0.0;
+
+  /**
+   *  @brief Progress measure of each group in the previous iteration.
+   */
+  std::vector<real_t> prev_sums_sq_sines_;
+};
+
+} // namespace grs
+} // namespace parallel
+} // namespace tanuki
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef TANUKI_PARALLEL_GRS_RING_ACTUATOR_H
+#define TANUKI_PARALLEL_GRS_RING_ACTUATOR_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include <armadillo>
+#include <mpi.h>
+
+#include "tanuki/math/linear/indexed_vector_pair.h"
+#include "tanuki/math/linear/rotation_matrix_spec.h"
+#include "tanuki/number/types.h"
+#include "tanuki/parallel/concurrent_actuator.h"
+#include "tanuki/parallel/grs/actuator.h"
+
+namespace tanuki {
+namespace parallel {
+namespace grs {
+
+using arma::Mat;
+
+using math::linear::IndexedVectorPair;
+using math::linear::RotationMatrixSpec;
+
+using tanuki::number::real_t;
+
+/**
+ *  @brief Actuator of a one-sided GRS from the right with the columns
+ *  distributed across MPI processes.
+ *
+ *  Unlike @link Actuator @endlink, which keeps a replica of the whole matrix
+ *  at each host, each MPI process only holds its own columns, which are split
+ *  into two blocks. Blocks are paired by a round-robin tournament of the
+ *  blocks that is arranged as a ring (Brent and Luk 1985). In each round of
+ *  the tournament (a block round), each MPI process pairs the columns in the
+ *  union of its two blocks in a round-robin tournament, and the blocks are
+ *  then exchanged with the neighboring MPI processes. After all block rounds
+ *  of an iteration, each block is back at its owning MPI process. Memory per
+ *  MPI process is therefore proportional to the number of columns that it
+ *  owns.
+ *
+ *  @tparam T
+ *    Type of elements in an Armadillo matrix.
+ */
+template <typename T>
+class RingActuator final : public ConcurrentActuator<
+    const IndexedVectorPair<T> &, RotationMatrixSpec, Mat<T>, Result<T>> {
+ public:
+  /**
+   *  @brief Type of the inquiry function.
+   *
+   *  See @link Actuator::InquiryFn @endlink.
+   */
+  using InquiryFn =
+      std::function<RotationMatrixSpec(const IndexedVectorPair<T> &)>;
+
+  /**
+   *  @brief Type of the convergence checker.
+   */
+  using ConvergenceFn = std::function<bool(const Mat<T> &, const Mat<T> &)>;
+
+  /**
+   *  @param mpi_comm
+   *    MPI communicator. The level of thread support must be at least
+   *    <tt>MPI_THREAD_FUNNELED</tt>.
+   *
+   *  @param max_threads
+   *    Maximum number of threads to use. It cannot exceed
+   *    <tt>omp_get_max_threads()</tt>.
+   *
+   *  @param init_relax
+   *    Initial relaxation parameter. If it is not in the range \f$ [0, 1) \f$,
+   *    <tt>std::domain_error</tt> is thrown.
+   *
+   *  @param max_iterations
+   *    Maximum number of iterations. If not positive,
+   *    <tt>std::domain_error</tt> is thrown.
+   *
+   *  @param relax_fn
+   *    Function that returns the relaxation parameter to use for the next
+   *    block round. Arguments are iteration index, previous relaxation
+   *    parameter, and current block round index, respectively. If the next
+   *    relaxation parameter is not in the range \f$ [0, 1) \f$,
+   *    <tt>std::domain_error</tt> is thrown.
+   *
+   *  @param convergence_checker
+   *    Function that returns whether convergence is attained given the
+   *    previous and current columns, respectively, that are owned by this MPI
+   *    process. Convergence is attained only if it is attained at all MPI
+   *    processes.
+   */
+  RingActuator(
+      MPI_Comm mpi_comm,
+      size_t max_threads,
+      real_t init_relax,
+      size_t max_iterations,
+      std::function<real_t(size_t, real_t, size_t)> relax_fn,
+      ConvergenceFn convergence_checker);
+
+  /**
+   *  @brief Actuates GRS.
+   *
+   *  The rotation returned from the inquiry function is not relaxed.
+   *  Relaxation is performed by the actuator. Matrix index pair is always
+   *  @link MatrixIndexPair::PairType::COLUMNS @endlink with global column
+   *  indices.
+   *
+   *  All MPI processes must invoke this outside any OpenMP parallel region.
+   *
+   *  @param input
+   *    Columns owned by this MPI process. Columns of the whole matrix are
+   *    distributed contiguously in the order of rank. Number of rows must be
+   *    the same at all MPI processes, and the total number of columns must be
+   *    at least two (otherwise <tt>std::length_error</tt> is thrown).
+   *
+   *  @return
+   *    Result whose transform is the transformed columns owned by this MPI
+   *    process.
+   */
+  Result<T> Actuate(const Mat<T> &input, InquiryFn inquiry_fn) override;
+
+  MPI_Comm mpi_comm() const override;
+
+  size_t max_threads() const override;
+
+ private:
+  /**
+   *  @brief Rotates the columns in the union of two blocks by a round-robin
+   *  tournament of the columns.
+   *
+   *  It must be invoked outside of any OpenMP parallel region.
+   *
+   *  @param block_firsts
+   *    Global indices of the first columns of the two blocks.
+   *
+   *  @param relaxation
+   *    Relaxation parameter.
+   *
+   *  @param blocks
+   *    Two blocks whose columns are rotated.
+   *
+   *  @param max_abs_sine
+   *    Maximum magnitude of the sines of the unrelaxed rotations to update.
+   *
+   *  @param sum_sq_sines
+   *    Sum of the squares of the sines of the unrelaxed rotations to add to.
+   */
+  void RotateBlockPair(
+      const size_t (&block_firsts)[2],
+      real_t relaxation,
+      InquiryFn inquiry_fn,
+      Mat<T> (&blocks)[2],
+      real_t &max_abs_sine,
+      real_t &sum_sq_sines) const;
+
+  /**
+   *  @brief MPI communicator.
+   */
+  MPI_Comm mpi_comm_;
+
+  /**
+   *  @brief Rank of this MPI process in @link mpi_comm_ @endlink.
+   */
+  int mpi_rank_;
+
+  /**
+   *  @brief Number of MPI processes in @link mpi_comm_ @endlink.
+   */
+  int mpi_comm_size_;
+
+  /**
+   *  @brief Maximum number of threads to use.
+   */
+  const size_t max_threads_;
+
+  /**
+   *  @brief Relaxation parameter.
+   */
+  const real_t init_relax_;
+
+  /**
+   *  @brief Maximum number of iterations.
+   */
+  const size_t max_iterations_;
+
+  /**
+   *  @brief Function that returns the relaxation parameter to use for the next
+   *  block round.
+   */
+  const std::function<real_t(size_t, real_t, size_t)> relax_fn_;
+
+  /**
+   *  @brief Convergence checker.
+   */
+  const ConvergenceFn convergence_checker_;
+};
+
+} // namespace grs
+} // namespace parallel
+} // namespace tanuki
+
+#include "tanuki/parallel/grs/ring_actuator.hxx"
+
+#endif
@@ -0,0 +1,401 @@
+#ifndef TANUKI_PARALLEL_GRS_RING_ACTUATOR_HXX
+#define TANUKI_PARALLEL_GRS_RING_ACTUATOR_HXX
+
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include <omp.h>
+
+#include "tanuki/common/divider/group_delimiter.h"
+#include "tanuki/math/combinatorics/round_robin_tourney.h"
+#include "tanuki/math/linear/matrix_index_pair.h"
+#include "tanuki/parallel/mpi/mpi_basic_datatype.h"
+
+namespace tanuki {
+namespace parallel {
+namespace grs {
+
+using std::vector;
+
+using arma::Col;
+
+using common::divider::GroupIndices;
+using math::combinatorics::RoundRobinTourney;
+using math::linear::ApplyGivensRotation;
+using math::linear::MatrixIndexPair;
+using parallel::mpi::MpiBasicDatatype;
+
+template <typename T>
+RingActuator<T>::RingActuator(
+    MPI_Comm mpi_comm,
+    size_t max_threads,
+    real_t init_relax,
+    size_t max_iterations,
+    std::function<real_t(size_t, real_t, size_t)> relax_fn,
+    ConvergenceFn convergence_checker)
+        : mpi_comm_(mpi_comm),
+          max_threads_(max_threads),
+          init_relax_(init_relax),
+          max_iterations_(max_iterations),
+          relax_fn_(relax_fn),
+          convergence_checker_(convergence_checker) {
+  int thread_support;
+  MPI_Query_thread(&thread_support);
+  assert(thread_support >= MPI_THREAD_FUNNELED);
+
+  assert(max_threads_ <= omp_get_max_threads());
+
+  if (init_relax_ < 0.0 || init_relax_ >= 1.0) {
+    throw std::domain_error(
+        "Relaxation parameter is not in the interval [0, 1).");
+  }
+
+  if (max_iterations_ == 0) {
+    throw std::domain_error("Maximum number of iterations is not positive.");
+  }
+
+  MPI_Comm_rank(mpi_comm_, &mpi_rank_);
+  MPI_Comm_size(mpi_comm_, &mpi_comm_size_);
+}
+
+template <typename T>
+Result<T> RingActuator<T>::Actuate(const Mat<T> &input, InquiryFn inquiry_fn) {
+  assert(!omp_in_parallel());
+
+  {
+    unsigned long long max_num_rows = input.n_rows;
+
+    MPI_Allreduce(
+        MPI_IN_PLACE, &max_num_rows, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX,
+        mpi_comm_);
+
+    if (max_num_rows != input.n_rows || input.n_rows == 0) {
+      throw std::length_error(
+          "Number of rows of the input matrix is not the same at all MPI "
+          "processes or is zero.");
+    }
+  }
+
+  const size_t num_blocks = 2 * mpi_comm_size_;
+
+  // Number of columns owned by each MPI process.
+  vector<unsigned long long> proc_num_cols(mpi_comm_size_);
+
+  {
+    const unsigned long long num_cols = input.n_cols;
+
+    MPI_Allgather(
+        &num_cols, 1, MPI_UNSIGNED_LONG_LONG,
+        proc_num_cols.data(), 1, MPI_UNSIGNED_LONG_LONG,
+        mpi_comm_);
+  }
+
+  // Global index of the first column and the number of columns of each block,
+  // where the blocks of an MPI process are at indices twice its rank and one
+  // more than that.
+  vector<size_t> block_firsts(num_blocks);
+  vector<size_t> block_sizes(num_blocks);
+
+  {
+    size_t first = 0;
+
+    for (int rank = 0; rank != mpi_comm_size_; ++rank) {
+      block_firsts[2 * rank] = first;
+      block_sizes[2 * rank] = proc_num_cols[rank] / 2;
+
+      block_firsts[2 * rank + 1] = first + block_sizes[2 * rank];
+      block_sizes[2 * rank + 1] = proc_num_cols[rank] - block_sizes[2 * rank];
+
+      first += proc_num_cols[rank];
+    }
+
+    if (first < 2) {
+      throw std::length_error(
+          "Invalid size of the input matrix to transform.");
+    }
+  }
+
+  // Position in the ring, where the top and bottom blocks of the MPI
+  // processes are at the first and second halves, respectively, with the
+  // bottom blocks in reverse order of rank.
+  const auto position = [this](int rank, size_t slot) -> size_t {
+    return slot == 0 ? rank : 2 * mpi_comm_size_ - 1 - rank;
+  };
+
+  // Rank and slot (0 for top and 1 for bottom) of a position in the ring.
+  const auto owner = [this](size_t pos) -> std::pair<int, size_t> {
+    return pos < static_cast<size_t>(mpi_comm_size_) ?
+        std::make_pair(static_cast<int>(pos), size_t(0)) :
+        std::make_pair(static_cast<int>(2 * mpi_comm_size_ - 1 - pos),
+                       size_t(1));
+  };
+
+  // Position that a block moves to after a block round. Block at position 0
+  // is fixed.
+  const auto next_position = [num_blocks](size_t pos) -> size_t {
+    return pos == 0 ? 0 : (pos == num_blocks - 1 ? 1 : pos + 1);
+  };
+
+  // Position that a block moves from before a block round.
+  const auto prev_position = [num_blocks](size_t pos) -> size_t {
+    return pos == 0 ? 0 : (pos == 1 ? num_blocks - 1 : pos - 1);
+  };
+
+  // Block index at each position in the ring.
+  vector<size_t> ring(num_blocks);
+
+  for (int rank = 0; rank != mpi_comm_size_; ++rank) {
+    ring[position(rank, 0)] = 2 * rank;
+    ring[position(rank, 1)] = 2 * rank + 1;
+  }
+
+  // Blocks held by this MPI process.
+  Mat<T> blocks[2] = {
+    Mat<T>(input.memptr(), input.n_rows, block_sizes[2 * mpi_rank_]),
+    Mat<T>(
+        input.memptr() + input.n_rows * block_sizes[2 * mpi_rank_],
+        input.n_rows, block_sizes[2 * mpi_rank_ + 1])
+  };
+
+  // Columns owned by this MPI process from the previous iteration to check
+  // for convergence.
+  Mat<T> prev_matrix(input);
+
+  real_t relaxation = init_relax_;
+
+  Result<T> retval;
+  retval.has_converged = false;
+
+  for (size_t iter = 0; iter != max_iterations_; ++iter) {
+    // Maximum magnitude and sum of squares of the sines of the unrelaxed
+    // rotations computed by this MPI process in the iteration.
+    real_t max_abs_sine = 0.0;
+    real_t sum_sq_sines = 0.0;
+
+    // Number of block rounds is the number of rounds in a round-robin
+    // tournament of the blocks, after which the ring is restored.
+    for (size_t br = 0; br != num_blocks - 1; ++br) {
+      const size_t block_pair_firsts[2] = {
+        block_firsts[ring[position(mpi_rank_, 0)]],
+        block_firsts[ring[position(mpi_rank_, 1)]]
+      };
+
+      RotateBlockPair(
+          block_pair_firsts, relaxation, inquiry_fn, blocks,
+          max_abs_sine, sum_sq_sines);
+
+      // Exchange the blocks with the neighbors in the ring.
+      {
+        Mat<T> next_blocks[2];
+        vector<MPI_Request> requests;
+        requests.reserve(4);
+
+        for (size_t slot = 0; slot != 2; ++slot) {
+          const auto prev_pos = prev_position(position(mpi_rank_, slot));
+          const auto src = owner(prev_pos);
+
+          next_blocks[slot].set_size(
+              input.n_rows, block_sizes[ring[prev_pos]]);
+
+          if (src.first != mpi_rank_) {
+            requests.emplace_back();
+
+            MPI_Irecv(
+                next_blocks[slot].memptr(), next_blocks[slot].n_elem,
+                MpiBasicDatatype<T>(), src.first, slot, mpi_comm_,
+                &requests.back());
+          }
+        }
+
+        for (size_t slot = 0; slot != 2; ++slot) {
+          const auto dest = owner(next_position(position(mpi_rank_, slot)));
+
+          if (dest.first != mpi_rank_) {
+            requests.emplace_back();
+
+            MPI_Isend(
+                blocks[slot].memptr(), blocks[slot].n_elem,
+                MpiBasicDatatype<T>(), dest.first, dest.second, mpi_comm_,
+                &requests.back());
+          } else {
+            next_blocks[dest.second] = blocks[slot];
+          }
+        }
+
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+        blocks[0] = std::move(next_blocks[0]);
+        blocks[1] = std::move(next_blocks[1]);
+
+        vector<size_t> next_ring(num_blocks);
+
+        for (size_t pos = 0; pos != num_blocks; ++pos) {
+          next_ring[next_position(pos)] = ring[pos];
+        }
+
+        ring = std::move(next_ring);
+      }
+
+      relaxation = relax_fn_(iter, relaxation, br);
+
+      if (relaxation < 0.0 || relaxation >= 1.0) {
+        throw std::domain_error(
+            "Relaxation parameter is not in the interval [0, 1).");
+      }
+    }
+
+    MPI_Allreduce(
+        MPI_IN_PLACE, &max_abs_sine, 1, MPI_DOUBLE, MPI_MAX, mpi_comm_);
+
+    MPI_Allreduce(
+        MPI_IN_PLACE, &sum_sq_sines, 1, MPI_DOUBLE, MPI_SUM, mpi_comm_);
+
+    retval.max_abs_sine = max_abs_sine;
+    retval.sum_sq_sines = sum_sq_sines;
+
+    // Blocks are back at their owning MPI processes.
+    Mat<T> curr_matrix(arma::join_horiz(blocks[0], blocks[1]));
+
+    auto has_converged = convergence_checker_(prev_matrix, curr_matrix);
+
+    MPI_Allreduce(
+        MPI_IN_PLACE, &has_converged, 1, MPI_CXX_BOOL, MPI_LAND, mpi_comm_);
+
+    retval.num_iters = iter + 1;
+
+    if (has_converged) {
+      retval.has_converged = true;
+      break;
+    } else {
+      prev_matrix = std::move(curr_matrix);
+    }
+  }
+
+  retval.transform = arma::join_horiz(blocks[0], blocks[1]);
+
+  return retval;
+}
+
+template <typename T>
+MPI_Comm RingActuator<T>::mpi_comm() const {
+  return mpi_comm_;
+}
+
+template <typename T>
+size_t RingActuator<T>::max_threads() const {
+  return max_threads_;
+}
+
+template <typename T>
+void RingActuator<T>::RotateBlockPair(
+    const size_t (&block_firsts)[2],
+    real_t relaxation,
+    InquiryFn inquiry_fn,
+    Mat<T> (&blocks)[2],
+    real_t &max_abs_sine,
+    real_t &sum_sq_sines) const {
+  assert(!omp_in_parallel());
+  assert(blocks[0].n_rows == blocks[1].n_rows);
+
+  const size_t num_rows = blocks[0].n_rows;
+  const size_t num_cols = blocks[0].n_cols + blocks[1].n_cols;
+
+  if (num_cols < 2) {
+    return;
+  }
+
+  // Pointer to and global index of each column in the union of the blocks.
+  vector<T *> col_ptrs;
+  vector<size_t> col_indices;
+
+  for (size_t slot = 0; slot != 2; ++slot) {
+    for (size_t j = 0; j != blocks[slot].n_cols; ++j) {
+      col_ptrs.push_back(blocks[slot].colptr(j));
+      col_indices.push_back(block_firsts[slot] + j);
+    }
+  }
+
+  // Local column indices as competitors in a round-robin tournament, where
+  // each round is a non-conflicting rotation set.
+  RoundRobinTourney<long long> tourney(num_cols);
+
+  #pragma omp parallel default(shared)
+  {
+    const auto thread_num = omp_get_thread_num();
+
+    // Rotation statistics of this thread.
+    real_t thread_max_abs_sine = 0.0;
+    real_t thread_sum_sq_sines = 0.0;
+
+    for (const auto &rotation_set : tourney) {
+      // Delimitation of rotation pairs by threads.
+      const auto chunk_indices = GroupIndices(
+          0, rotation_set.n_rows, max_threads());
+
+      for (size_t rp = thread_num < max_threads() ?
+               chunk_indices[thread_num] : 0;
+           thread_num < max_threads() && rp != chunk_indices[thread_num + 1];
+           ++rp) {
+        auto first = rotation_set(rp, 0);
+        auto second = rotation_set(rp, 1);
+
+        if (first == -1 || second == -1) {
+          continue;
+        }
+
+        // Ensure the first global index is less than the second.
+        if (col_indices[first] > col_indices[second]) {
+          std::swap(first, second);
+        }
+
+        MatrixIndexPair indices = {
+          .type = MatrixIndexPair::PairType::COLUMNS,
+          .first = col_indices[first],
+          .second = col_indices[second]
+        };
+
+        const IndexedVectorPair<T> vectors = {
+          .indices = indices,
+          .first = Col<T>(col_ptrs[first], num_rows, false, true),
+          .second = Col<T>(col_ptrs[second], num_rows, false, true)
+        };
+
+        // Unrelaxed rotation.
+        const auto rotation_spec = inquiry_fn(vectors);
+
+        thread_max_abs_sine = std::fmax(
+            thread_max_abs_sine, std::abs(rotation_spec.sine));
+
+        thread_sum_sq_sines += rotation_spec.sine * rotation_spec.sine;
+
+        const auto relaxed_angle = (1.0 - relaxation) *
+            std::atan2(rotation_spec.sine, rotation_spec.cosine);
+
+        const RotationMatrixSpec relaxed_spec = {
+          .cosine = std::cos(relaxed_angle),
+          .sine = std::sin(relaxed_angle)
+        };
+
+        ApplyGivensRotation(
+            relaxed_spec, num_rows, col_ptrs[first], col_ptrs[second]);
+      }
+
+      // Wait for the rotation set to be applied by all threads.
+      #pragma omp barrier
+    }
+
+    #pragma omp critical
+    {
+      max_abs_sine = std::fmax(max_abs_sine, thread_max_abs_sine);
+      sum_sq_sines += thread_sum_sq_sines;
+    }
+  }
+}
+
+} // namespace grs
+} // namespace parallel
+} // namespace tanuki
+
+#endif
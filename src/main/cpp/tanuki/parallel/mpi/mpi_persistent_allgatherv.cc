@@ -0,0 +1,87 @@
+#include "tanuki/parallel/mpi/mpi_persistent_allgatherv.h"
+
+#include <cassert>
+
+namespace tanuki {
+namespace parallel {
+namespace mpi {
+
+MpiPersistentAllgatherv::MpiPersistentAllgatherv(
+    MPI_Comm mpi_comm,
+    void *buf,
+    const std::vector<int> &recv_counts,
+    const std::vector<int> &displs,
+    MPI_Datatype datatype)
+        : mpi_comm_(mpi_comm),
+          buf_(buf),
+          recv_counts_(recv_counts),
+          displs_(displs),
+          datatype_(datatype) {
+  assert(recv_counts_.size() == displs_.size());
+
+#if MPI_VERSION >= 4
+  // Return errors instead of aborting while setting up the persistent
+  // request, since an MPI library can declare MPI 4.0 without supporting
+  // persistent collectives on every communicator.
+  MPI_Errhandler prev_errhandler;
+  MPI_Comm_get_errhandler(mpi_comm_, &prev_errhandler);
+  MPI_Comm_set_errhandler(mpi_comm_, MPI_ERRORS_RETURN);
+
+  int is_persistent = MPI_Allgatherv_init(
+      MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+      buf_, recv_counts_.data(), displs_.data(), datatype_,
+      mpi_comm_, MPI_INFO_NULL, &request_) == MPI_SUCCESS;
+
+  MPI_Comm_set_errhandler(mpi_comm_, prev_errhandler);
+  MPI_Errhandler_free(&prev_errhandler);
+
+  // Persistent request is used only if it is set up by all MPI processes, so
+  // that they either start it or fall back to nonblocking gathering together.
+  MPI_Allreduce(
+      MPI_IN_PLACE, &is_persistent, 1, MPI_INT, MPI_LAND, mpi_comm_);
+
+  if (!is_persistent && request_ != MPI_REQUEST_NULL) {
+    MPI_Request_free(&request_);
+  }
+
+  if (!is_persistent) {
+    request_ = MPI_REQUEST_NULL;
+  }
+#endif
+}
+
+MpiPersistentAllgatherv::~MpiPersistentAllgatherv() {
+  if (request_ != MPI_REQUEST_NULL) {
+    MPI_Request_free(&request_);
+  }
+}
+
+void MpiPersistentAllgatherv::Run() {
+  Start();
+  Wait();
+}
+
+void MpiPersistentAllgatherv::Start() {
+  if (request_ != MPI_REQUEST_NULL) {
+    MPI_Start(&request_);
+  } else {
+    assert(nonblocking_request_ == MPI_REQUEST_NULL);
+
+    MPI_Iallgatherv(
+        MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+        buf_, recv_counts_.data(), displs_.data(), datatype_,
+        mpi_comm_, &nonblocking_request_);
+  }
+}
+
+void MpiPersistentAllgatherv::Wait() {
+  if (request_ != MPI_REQUEST_NULL) {
+    MPI_Wait(&request_, MPI_STATUS_IGNORE);
+  } else {
+    MPI_Wait(&nonblocking_request_, MPI_STATUS_IGNORE);
+  }
+}
+
+} // namespace mpi
+} // namespace parallel
+} // namespace tanuki
@@ -0,0 +1,127 @@
+#ifndef TANUKI_PARALLEL_MPI_MPI_PERSISTENT_ALLGATHERV_H
+#define TANUKI_PARALLEL_MPI_MPI_PERSISTENT_ALLGATHERV_H
+
+#include <vector>
+
+#include <mpi.h>
+
+namespace tanuki {
+namespace parallel {
+namespace mpi {
+
+/**
+ *  @brief In-place gathering of variable numbers of elements from all MPI
+ *  processes that is repeated with the same buffer, counts, and
+ *  displacements.
+ *
+ *  If the MPI library supports MPI 4.0, the collective is set up once as a
+ *  persistent request with <tt>MPI_Allgatherv_init</tt> and is started at
+ *  each run. Otherwise, or if setting up the persistent request fails on any
+ *  MPI process, it falls back to <tt>MPI_Iallgatherv</tt> at each run.
+ *
+ *  An instance of this class is to be kept by each MPI process in the
+ *  communicator.
+ */
+class MpiPersistentAllgatherv final {
+ public:
+  /**
+   *  It must be invoked by all MPI processes in <tt>mpi_comm</tt>.
+   *
+   *  @param mpi_comm
+   *    MPI communicator.
+   *
+   *  @param buf
+   *    Buffer that receives the elements from all MPI processes, where the
+   *    elements of this MPI process are already in place. It must remain
+   *    valid for the lifetime of this object.
+   *
+   *  @param recv_counts
+   *    Number of elements from each MPI process.
+   *
+   *  @param displs
+   *    Displacement, in elements, of the elements from each MPI process.
+   *
+   *  @param datatype
+   *    MPI datatype of the elements.
+   */
+  MpiPersistentAllgatherv(
+      MPI_Comm mpi_comm,
+      void *buf,
+      const std::vector<int> &recv_counts,
+      const std::vector<int> &displs,
+      MPI_Datatype datatype);
+
+  MpiPersistentAllgatherv(const MpiPersistentAllgatherv &other) = delete;
+
+  MpiPersistentAllgatherv &operator=(
+      const MpiPersistentAllgatherv &other) = delete;
+
+  ~MpiPersistentAllgatherv();
+
+  /**
+   *  @brief Gathers the elements and waits for completion.
+   *
+   *  It must be invoked by all MPI processes in the communicator.
+   */
+  void Run();
+
+  /**
+   *  @brief Starts gathering the elements without waiting for completion.
+   *
+   *  It must be invoked by all MPI processes in the communicator, and the
+   *  buffer must not be accessed until @link Wait @endlink returns.
+   */
+  void Start();
+
+  /**
+   *  @brief Waits for the completion of the gathering started by @link Start
+   *  @endlink.
+   */
+  void Wait();
+
+ private:
+  /**
+   *  @brief MPI communicator.
+   */
+  MPI_Comm mpi_comm_;
+
+  /**
+   *  @brief Receive buffer.
+   */
+  void *buf_;
+
+  /**
+   *  @brief Number of elements from each MPI process, which must outlive the
+   *  persistent request.
+   */
+  const std::vector<int> recv_counts_;
+
+  /**
+   *  @brief Displacements of the elements from each MPI process, which must
+   *  outlive the persistent request.
+   */
+  const std::vector<int> displs_;
+
+  /**
+   *  @brief MPI datatype of the elements.
+   */
+  MPI_Datatype datatype_;
+
+  /**
+   *  @brief Persistent request, or <tt>MPI_REQUEST_NULL</tt> if persistent
+   *  collectives are not supported.
+   */
+  MPI_Request request_ = MPI_REQUEST_NULL;
+
+  /**
+   *  @brief Request of the started nonblocking gathering if persistent
+   *  collectives are not supported.
+   */
+  MPI_Request nonblocking_request_ = MPI_REQUEST_NULL;
+};
+
+} // namespace mpi
+} // namespace parallel
+} // namespace tanuki
+
+#endif
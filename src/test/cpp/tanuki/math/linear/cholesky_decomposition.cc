@@ -0,0 +1,68 @@
+#include <tanuki.h>
+
+#include <cstddef>
+
+#include <armadillo>
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#define APPROX_EQUAL_ABS_TOL 1.0e-6
+
+namespace tanuki {
+namespace math {
+namespace linear {
+
+using arma::Mat;
+
+using tanuki::number::complex_t;
+using tanuki::number::real_t;
+
+/**
+ *  @brief Tests the Cholesky decomposition, whose rows are distributed
+ *  cyclically across the MPI processes, against that of Armadillo.
+ *
+ *  @param num_rows
+ *    Number of rows of the random Hermitian positive-definite matrix, which
+ *    need not be a multiple of the number of MPI processes.
+ */
+template <typename T>
+void TEST_CholeskyDecomposition_Random(size_t num_rows) {
+  Mat<T> x(num_rows, num_rows, arma::fill::randu);
+  MPI_Bcast(x.memptr(), x.n_elem, MpiBasicDatatype<T>(), 0, MPI_COMM_WORLD);
+
+  const Mat<T> a =
+      x.t() * x + Mat<T>(num_rows, num_rows, arma::fill::eye) * T(num_rows);
+
+  CholeskyDecomposition<T> decomposition(a, MPI_COMM_WORLD);
+
+  const auto &l = decomposition.l();
+
+  ASSERT_EQ(arma::size(l), arma::size(a));
+
+  // Test against the lower triangular matrix of Armadillo.
+  {
+    const bool is_l_equal = arma::approx_equal(
+        l, Mat<T>(arma::chol(a, "lower")), "absdiff", APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_l_equal);
+  }
+
+  // Test that the product of the factors gives the original matrix.
+  {
+    const bool is_decompose_equal = arma::approx_equal(
+        Mat<T>(l * decomposition.lt()), a, "absdiff", APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_decompose_equal);
+  }
+}
+
+TEST(CholeskyDecomposition, Random) {
+  for (const size_t num_rows : {1, 2, 7, 16}) {
+    TEST_CholeskyDecomposition_Random<real_t>(num_rows);
+    TEST_CholeskyDecomposition_Random<complex_t>(num_rows);
+  }
+}
+
+} // namespace linear
+} // namespace math
+} // namespace tanuki
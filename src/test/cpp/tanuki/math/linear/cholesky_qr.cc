@@ -0,0 +1,114 @@
+#include <tanuki.h>
+
+#include <cstddef>
+#include <functional>
+
+#include <armadillo>
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#define APPROX_EQUAL_ABS_TOL 1.0e-6
+#define APPROX_EQUAL_REL_TOL 1.0e-3
+
+namespace tanuki {
+namespace math {
+namespace linear {
+
+using arma::Mat;
+
+using tanuki::number::complex_t;
+using tanuki::number::real_t;
+
+/**
+ *  @brief Tests a variant of CholeskyQR as a method of thin QR decomposition.
+ *
+ *  @tparam T
+ *    Must be @link tanuki::number::real_t @endlink or @link
+ *    tanuki::number::complex_t @endlink.
+ *
+ *  @param decompose
+ *    Variant of CholeskyQR.
+ *
+ *  @param a
+ *    Matrix to decompose, which is the same across MPI processes.
+ */
+template <typename T>
+void TEST_CholeskyQr_Qr(
+    std::function<QrDecomposition<T>(MPI_Comm, const Mat<T> &)> decompose,
+    const Mat<T> &a) {
+  const auto qr = decompose(MPI_COMM_WORLD, a);
+
+  ASSERT_EQ(arma::size(qr.q), arma::size(a));
+  ASSERT_TRUE(qr.r.is_square());
+  ASSERT_EQ(qr.r.n_rows, a.n_cols);
+
+  // Test that the columns of Q are orthonormal.
+  {
+    const bool is_q_ortho = arma::approx_equal(
+        qr.q.t() * qr.q,
+        Mat<T>(a.n_cols, a.n_cols, arma::fill::eye),
+        "absdiff",
+        APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_q_ortho);
+  }
+
+  // Test that the product of decomposition factors gives the original matrix.
+  {
+    const bool is_decompose_equal = arma::approx_equal(
+        qr.q * qr.r,
+        a,
+        "reldiff",
+        APPROX_EQUAL_REL_TOL);
+
+    ASSERT_TRUE(is_decompose_equal);
+  }
+}
+
+/**
+ *  @brief Tests the variants of CholeskyQR on a random matrix.
+ */
+template <typename T>
+void TEST_CholeskyQr_Random(size_t num_rows, size_t num_cols) {
+  Mat<T> a(num_rows, num_cols, arma::fill::randu);
+  MPI_Bcast(a.memptr(), a.n_elem, MpiBasicDatatype<T>(), 0, MPI_COMM_WORLD);
+
+  TEST_CholeskyQr_Qr<T>(CholeskyQr2<T>, a);
+  TEST_CholeskyQr_Qr<T>(ShiftedCholeskyQr3<T>, a);
+  TEST_CholeskyQr_Qr<T>(CholeskyQr<T>, a);
+}
+
+/**
+ *  @brief Tests CholeskyQR on an ill-conditioned matrix, which requires the
+ *  shifted variant.
+ */
+template <typename T>
+void TEST_CholeskyQr_IllConditioned(size_t num_rows, size_t num_cols) {
+  Mat<T> a(num_rows, num_cols, arma::fill::randu);
+  Mat<T> perturbation(num_rows, 1, arma::fill::randu);
+
+  // Make the last column nearly parallel to the first column.
+  a.col(num_cols - 1) = a.col(0) + perturbation * T(1.0e-10);
+
+  MPI_Bcast(a.memptr(), a.n_elem, MpiBasicDatatype<T>(), 0, MPI_COMM_WORLD);
+
+  TEST_CholeskyQr_Qr<T>(CholeskyQr<T>, a);
+}
+
+/**
+ *  @brief Tests CholeskyQR as a method of thin QR decomposition.
+ */
+TEST(CholeskyQr, Qr) {
+  TEST_CholeskyQr_Random<real_t>(8, 8);
+  TEST_CholeskyQr_Random<complex_t>(8, 8);
+
+  TEST_CholeskyQr_Random<real_t>(64, 5);
+  TEST_CholeskyQr_Random<complex_t>(64, 5);
+
+  TEST_CholeskyQr_IllConditioned<real_t>(64, 5);
+  TEST_CholeskyQr_IllConditioned<complex_t>(64, 5);
+}
+
+} // namespace linear
+} // namespace math
+} // namespace tanuki
@@ -70,6 +70,158 @@ TEST(IteratedGramSchmidt, Qr) {
   TEST_IteratedGramSchmidt_Qr<complex_t>(8, 5);
 }
 
+/**
+ *  @brief Tests iterated Gram-Schmidt process as a method of thin QR
+ *  decomposition.
+ *
+ *  @tparam T
+ *    Must be @link tanuki::number::real_t @endlink or @link
+ *    tanuki::number::complex_t @endlink.
+ */
+template <typename T>
+void TEST_IteratedGramSchmidt_ThinQr(size_t num_rows, size_t num_cols) {
+  Mat<T> a(num_rows, num_cols, arma::fill::randu);
+  MPI_Bcast(a.memptr(), a.n_elem, MpiBasicDatatype<T>(), 0, MPI_COMM_WORLD);
+
+  auto qr = ThinIteratedGramSchmidt(MPI_COMM_WORLD, a);
+
+  ASSERT_EQ(arma::size(qr.q), arma::size(a));
+  ASSERT_TRUE(qr.r.is_square());
+  ASSERT_EQ(qr.r.n_rows, num_cols);
+
+  // Test that the columns of Q are orthonormal.
+  {
+    const bool is_q_ortho = arma::approx_equal(
+        qr.q.t() * qr.q,
+        Mat<T>(num_cols, num_cols, arma::fill::eye),
+        "absdiff",
+        APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_q_ortho);
+  }
+
+  // Test that the product of decomposition factors gives the original matrix.
+  {
+    const bool is_decompose_equal = arma::approx_equal(
+        qr.q * qr.r,
+        a,
+        "reldiff",
+        APPROX_EQUAL_REL_TOL);
+
+    ASSERT_TRUE(is_decompose_equal);
+  }
+
+  CompleteQrDecomposition(MPI_COMM_WORLD, 0.5, 1, 1.0e-5, qr);
+
+  ASSERT_TRUE(qr.q.is_square());
+  ASSERT_EQ(qr.r.n_rows, num_rows);
+
+  // Test that the completed Q is orthonormal.
+  {
+    const bool is_q_ortho = arma::approx_equal(
+        qr.q.t() * qr.q,
+        Mat<T>(arma::size(qr.q), arma::fill::eye),
+        "absdiff",
+        APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_q_ortho);
+  }
+
+  // Test that the completed decomposition still gives the original matrix.
+  {
+    const bool is_decompose_equal = arma::approx_equal(
+        qr.q * qr.r,
+        a,
+        "reldiff",
+        APPROX_EQUAL_REL_TOL);
+
+    ASSERT_TRUE(is_decompose_equal);
+  }
+}
+
+/**
+ *  @brief Tests iterated Gram-Schmidt process as a method of thin QR
+ *  decomposition.
+ */
+TEST(IteratedGramSchmidt, ThinQr) {
+  TEST_IteratedGramSchmidt_ThinQr<real_t>(8, 8);
+  TEST_IteratedGramSchmidt_ThinQr<complex_t>(8, 8);
+
+  TEST_IteratedGramSchmidt_ThinQr<real_t>(20, 5);
+  TEST_IteratedGramSchmidt_ThinQr<complex_t>(20, 5);
+}
+
+/**
+ *  @brief Tests extending a thin QR decomposition with new columns.
+ *
+ *  @tparam T
+ *    Must be @link tanuki::number::real_t @endlink or @link
+ *    tanuki::number::complex_t @endlink.
+ */
+template <typename T>
+void TEST_IteratedGramSchmidt_Extend(
+    size_t num_rows, size_t num_old_cols, size_t num_new_cols) {
+  Mat<T> a(num_rows, num_old_cols + num_new_cols, arma::fill::randu);
+  MPI_Bcast(a.memptr(), a.n_elem, MpiBasicDatatype<T>(), 0, MPI_COMM_WORLD);
+
+  auto qr = ThinIteratedGramSchmidt(
+      MPI_COMM_WORLD, Mat<T>(a.cols(0, num_old_cols - 1)));
+
+  ExtendIteratedGramSchmidt(
+      MPI_COMM_WORLD,
+      Mat<T>(a.cols(num_old_cols, a.n_cols - 1)),
+      0.5, 1,
+      qr);
+
+  ASSERT_EQ(arma::size(qr.q), arma::size(a));
+  ASSERT_TRUE(qr.r.is_square());
+  ASSERT_EQ(qr.r.n_rows, a.n_cols);
+
+  // Test that the columns of Q are orthonormal.
+  {
+    const bool is_q_ortho = arma::approx_equal(
+        qr.q.t() * qr.q,
+        Mat<T>(a.n_cols, a.n_cols, arma::fill::eye),
+        "absdiff",
+        APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_q_ortho);
+  }
+
+  // Test that R is upper triangular.
+  {
+    const bool is_r_upper = arma::approx_equal(
+        qr.r,
+        Mat<T>(arma::trimatu(qr.r)),
+        "absdiff",
+        APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_r_upper);
+  }
+
+  // Test that the product of decomposition factors gives the whole matrix.
+  {
+    const bool is_decompose_equal = arma::approx_equal(
+        qr.q * qr.r,
+        a,
+        "reldiff",
+        APPROX_EQUAL_REL_TOL);
+
+    ASSERT_TRUE(is_decompose_equal);
+  }
+}
+
+/**
+ *  @brief Tests extending a thin QR decomposition with new columns.
+ */
+TEST(IteratedGramSchmidt, Extend) {
+  TEST_IteratedGramSchmidt_Extend<real_t>(20, 5, 3);
+  TEST_IteratedGramSchmidt_Extend<complex_t>(20, 5, 3);
+
+  TEST_IteratedGramSchmidt_Extend<real_t>(8, 5, 3);
+  TEST_IteratedGramSchmidt_Extend<complex_t>(8, 5, 3);
+}
+
 } // namespace linear
 } // namespace math
 } // namespace tanuki
@@ -0,0 +1,88 @@
+#include <tanuki.h>
+
+#include <cstddef>
+
+#include <armadillo>
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#define APPROX_EQUAL_ABS_TOL 1.0e-6
+#define APPROX_EQUAL_REL_TOL 1.0e-3
+
+namespace tanuki {
+namespace math {
+namespace linear {
+
+using arma::Mat;
+
+using tanuki::number::complex_t;
+using tanuki::number::real_t;
+
+/**
+ *  @brief Tests TSQR as a method of thin QR decomposition.
+ *
+ *  @tparam T
+ *    Must be @link tanuki::number::real_t @endlink or @link
+ *    tanuki::number::complex_t @endlink.
+ */
+template <typename T>
+void TEST_TallSkinnyQr_Qr(size_t num_rows, size_t num_cols) {
+  Mat<T> a(num_rows, num_cols, arma::fill::randu);
+  MPI_Bcast(a.memptr(), a.n_elem, MpiBasicDatatype<T>(), 0, MPI_COMM_WORLD);
+
+  const auto qr = TallSkinnyQr(MPI_COMM_WORLD, a);
+
+  ASSERT_EQ(arma::size(qr.q), arma::size(a));
+  ASSERT_TRUE(qr.r.is_square());
+  ASSERT_EQ(qr.r.n_rows, num_cols);
+
+  // Test that the columns of Q are orthonormal.
+  {
+    const bool is_q_ortho = arma::approx_equal(
+        qr.q.t() * qr.q,
+        Mat<T>(num_cols, num_cols, arma::fill::eye),
+        "absdiff",
+        APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_q_ortho);
+  }
+
+  // Test that R is upper triangular.
+  {
+    const bool is_r_upper = arma::approx_equal(
+        qr.r,
+        Mat<T>(arma::trimatu(qr.r)),
+        "absdiff",
+        APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_r_upper);
+  }
+
+  // Test that the product of decomposition factors gives the original matrix.
+  {
+    const bool is_decompose_equal = arma::approx_equal(
+        qr.q * qr.r,
+        a,
+        "reldiff",
+        APPROX_EQUAL_REL_TOL);
+
+    ASSERT_TRUE(is_decompose_equal);
+  }
+}
+
+/**
+ *  @brief Tests TSQR as a method of thin QR decomposition.
+ */
+TEST(TallSkinnyQr, Qr) {
+  // Test square matrices.
+  TEST_TallSkinnyQr_Qr<real_t>(8, 8);
+  TEST_TallSkinnyQr_Qr<complex_t>(8, 8);
+
+  // Test tall-skinny matrices.
+  TEST_TallSkinnyQr_Qr<real_t>(64, 5);
+  TEST_TallSkinnyQr_Qr<complex_t>(64, 5);
+}
+
+} // namespace linear
+} // namespace math
+} // namespace tanuki
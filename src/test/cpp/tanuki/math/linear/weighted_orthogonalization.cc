@@ -0,0 +1,370 @@
+#include <tanuki.h>
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <armadillo>
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <omp.h>
+
+#define APPROX_EQUAL_ABS_TOL 1.0e-6
+#define CONVERGENCE_TOL 1.0e-10
+#define ZERO_ABS_THRESH 1.0e-10
+
+namespace tanuki {
+namespace math {
+namespace linear {
+
+using std::vector;
+
+using arma::Mat;
+
+using parallel::grs::Actuator;
+using parallel::grs::ActuatorOptions;
+using parallel::grs::ConvergenceCriterion;
+using parallel::grs::JacobiSidedness;
+
+using tanuki::number::real_t;
+
+/**
+ *  @brief Problem of WO that is the same across MPI processes.
+ */
+struct TEST_WeightedOrthogonalization_Problem final {
+ public:
+  /**
+   *  @brief Nonorthogonal matrix with normalized columns.
+   */
+  Mat<real_t> nonortho_matrix;
+
+  /**
+   *  @brief Orthonormal matrix whose columns are rotated.
+   */
+  Mat<real_t> prelim_ortho_matrix;
+
+  /**
+   *  @brief Orthogonalization weights.
+   */
+  vector<real_t> weights;
+};
+
+/**
+ *  @brief Creates a random problem of WO whose nonorthogonal matrix is a
+ *  perturbation of the orthonormal matrix.
+ */
+TEST_WeightedOrthogonalization_Problem TEST_WeightedOrthogonalization_Random(
+    size_t num_rows, size_t num_cols) {
+  Mat<real_t> prelim(num_rows, num_cols, arma::fill::randu);
+  Mat<real_t> perturbation(num_rows, num_cols, arma::fill::randu);
+  Mat<real_t> weights(num_cols, 1, arma::fill::randu);
+
+  MPI_Bcast(prelim.memptr(), prelim.n_elem, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+  MPI_Bcast(
+      perturbation.memptr(), perturbation.n_elem, MPI_DOUBLE, 0,
+      MPI_COMM_WORLD);
+
+  MPI_Bcast(weights.memptr(), weights.n_elem, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+  TEST_WeightedOrthogonalization_Problem retval;
+
+  {
+    Mat<real_t> r;
+    arma::qr_econ(retval.prelim_ortho_matrix, r, prelim);
+  }
+
+  retval.nonortho_matrix =
+      arma::normalise(retval.prelim_ortho_matrix + 0.3 * perturbation);
+
+  for (size_t j = 0; j != num_cols; ++j) {
+    retval.weights.push_back(0.5 + weights(j, 0));
+  }
+
+  return retval;
+}
+
+/**
+ *  @brief Creates an actuator without relaxation that converges by the
+ *  rotations.
+ */
+std::unique_ptr<Actuator<real_t>> TEST_WeightedOrthogonalization_Actuator(
+    const ActuatorOptions &options = ActuatorOptions()) {
+  ActuatorOptions rotations_options = options;
+  rotations_options.convergence_criterion = ConvergenceCriterion::ROTATIONS;
+  rotations_options.convergence_tol = CONVERGENCE_TOL;
+
+  return std::unique_ptr<Actuator<real_t>>(
+      new Actuator<real_t>(
+          MPI_COMM_WORLD,
+          omp_get_max_threads(),
+          JacobiSidedness::ONE_SIDED_RIGHT,
+          0.0,
+          4,
+          100,
+          [](size_t, real_t, size_t) -> real_t { return 0.0; },
+          [](const Mat<real_t> &, const Mat<real_t> &) -> bool {
+            return false;
+          },
+          rotations_options));
+}
+
+/**
+ *  @brief WO that evaluates each rotation from the inner products of the
+ *  nonorthogonal columns with the rotated columns, as before the overlap was
+ *  tracked through the actuator.
+ */
+parallel::grs::Result<real_t> TEST_WeightedOrthogonalization_Baseline(
+    const TEST_WeightedOrthogonalization_Problem &problem,
+    Actuator<real_t> &actuator) {
+  const auto &nonortho_matrix = problem.nonortho_matrix;
+  const auto &weights = problem.weights;
+
+  return actuator.Actuate(
+      problem.prelim_ortho_matrix,
+      Actuator<real_t>::InquiryFn(
+          [&nonortho_matrix, &weights](
+              const IndexedVectorPair<real_t> &vector_pair)
+              -> RotationMatrixSpec {
+            const auto i = vector_pair.indices.first;
+            const auto j = vector_pair.indices.second;
+
+            const real_t B =
+                weights[i] *
+                    arma::dot(nonortho_matrix.col(i), vector_pair.first) +
+                weights[j] *
+                    arma::dot(nonortho_matrix.col(j), vector_pair.second);
+
+            const real_t C =
+                weights[j] *
+                    arma::dot(nonortho_matrix.col(j), vector_pair.first) -
+                weights[i] *
+                    arma::dot(nonortho_matrix.col(i), vector_pair.second);
+
+            const real_t A = std::sqrt(B * B + C * C);
+
+            if (A < ZERO_ABS_THRESH) {
+              return CreateIdentityRotation();
+            }
+
+            return {
+              .cosine = B / A,
+              .sine = C / A
+            };
+          }));
+}
+
+/**
+ *  @brief Tests that tracking the overlap through the actuator gives the same
+ *  result as evaluating the inner products of the columns.
+ */
+TEST(WeightedOrthogonalization, Overlap) {
+  const auto problem = TEST_WeightedOrthogonalization_Random(24, 8);
+
+  const auto baseline_result = TEST_WeightedOrthogonalization_Baseline(
+      problem, *TEST_WeightedOrthogonalization_Actuator());
+
+  const auto result = WeightOrthogonalized(
+      problem.nonortho_matrix,
+      problem.prelim_ortho_matrix,
+      problem.weights,
+      ZERO_ABS_THRESH,
+      *TEST_WeightedOrthogonalization_Actuator());
+
+  ASSERT_TRUE(result.has_converged);
+  ASSERT_EQ(result.num_iters, baseline_result.num_iters);
+
+  const bool is_transform_equal = arma::approx_equal(
+      result.transform,
+      baseline_result.transform,
+      "absdiff",
+      APPROX_EQUAL_ABS_TOL);
+
+  ASSERT_TRUE(is_transform_equal);
+}
+
+/**
+ *  @brief Tests that skipping the pairs of zero-weight columns by the
+ *  active-set ordering gives the same weighted columns as rotating all pairs.
+ *
+ *  Zero-weight columns are only determined up to a rotation among
+ *  themselves, so they are not compared.
+ */
+TEST(WeightedOrthogonalization, ActiveSet) {
+  auto problem = TEST_WeightedOrthogonalization_Random(24, 8);
+
+  // Number of columns with nonzero weights.
+  const size_t num_weighted = 5;
+
+  for (size_t j = num_weighted; j != problem.weights.size(); ++j) {
+    problem.weights[j] = 0.0;
+  }
+
+  const auto all_pairs_result = WeightOrthogonalized(
+      problem.nonortho_matrix,
+      problem.prelim_ortho_matrix,
+      problem.weights,
+      ZERO_ABS_THRESH,
+      *TEST_WeightedOrthogonalization_Actuator());
+
+  // Default parallelization strategy uses the active-set ordering.
+  const auto active_set_result = WeightOrthogonalized(
+      MPI_COMM_WORLD,
+      problem.nonortho_matrix,
+      problem.prelim_ortho_matrix,
+      problem.weights,
+      100,
+      ZERO_ABS_THRESH);
+
+  ASSERT_TRUE(all_pairs_result.has_converged);
+  ASSERT_TRUE(active_set_result.has_converged);
+
+  const bool is_weighted_equal = arma::approx_equal(
+      active_set_result.transform.head_cols(num_weighted),
+      all_pairs_result.transform.head_cols(num_weighted),
+      "absdiff",
+      APPROX_EQUAL_ABS_TOL);
+
+  ASSERT_TRUE(is_weighted_equal);
+
+  // Test that the columns remain orthonormal.
+  {
+    const bool is_ortho = arma::approx_equal(
+        active_set_result.transform.t() * active_set_result.transform,
+        Mat<real_t>(
+            problem.weights.size(), problem.weights.size(), arma::fill::eye),
+        "absdiff",
+        APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_ortho);
+  }
+}
+
+/**
+ *  @brief Tests that WO warm-started from the rotation of a previous result
+ *  of the same problem, or from the previous result itself, converges
+ *  immediately to the same result.
+ */
+TEST(WeightedOrthogonalization, WarmStart) {
+  const auto problem = TEST_WeightedOrthogonalization_Random(24, 8);
+
+  const auto cold_result = WeightOrthogonalized(
+      MPI_COMM_WORLD,
+      problem.nonortho_matrix,
+      problem.prelim_ortho_matrix,
+      problem.weights,
+      100,
+      ZERO_ABS_THRESH);
+
+  ASSERT_TRUE(cold_result.has_converged);
+
+  // Rotation of the previous result from the orthonormal matrix.
+  const Mat<real_t> init_rotation =
+      problem.prelim_ortho_matrix.t() * cold_result.transform;
+
+  const auto warm_result = WeightOrthogonalized(
+      MPI_COMM_WORLD,
+      problem.nonortho_matrix,
+      problem.prelim_ortho_matrix,
+      problem.weights,
+      init_rotation,
+      100,
+      ZERO_ABS_THRESH);
+
+  ASSERT_TRUE(warm_result.has_converged);
+  ASSERT_LE(warm_result.num_iters, 2u);
+  ASSERT_LT(warm_result.num_iters, cold_result.num_iters);
+
+  const bool is_transform_equal = arma::approx_equal(
+      warm_result.transform,
+      cold_result.transform,
+      "absdiff",
+      APPROX_EQUAL_ABS_TOL);
+
+  ASSERT_TRUE(is_transform_equal);
+
+  // Test warm-starting from the previous result.
+  {
+    const auto result_warm_result = WeightOrthogonalized(
+        MPI_COMM_WORLD,
+        problem.nonortho_matrix,
+        problem.prelim_ortho_matrix,
+        problem.weights,
+        cold_result,
+        100,
+        ZERO_ABS_THRESH);
+
+    ASSERT_TRUE(result_warm_result.has_converged);
+    ASSERT_LE(result_warm_result.num_iters, 2u);
+
+    const bool is_result_transform_equal = arma::approx_equal(
+        result_warm_result.transform,
+        cold_result.transform,
+        "absdiff",
+        APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_result_transform_equal);
+  }
+}
+
+/**
+ *  @brief Tests that WO warm-started from a previous result of a problem with
+ *  a perturbed orthonormal matrix, as between SCF iterations, gives
+ *  orthonormal columns.
+ */
+TEST(WeightedOrthogonalization, WarmStartPerturbed) {
+  const auto prev_problem = TEST_WeightedOrthogonalization_Random(24, 8);
+
+  const auto prev_result = WeightOrthogonalized(
+      MPI_COMM_WORLD,
+      prev_problem.nonortho_matrix,
+      prev_problem.prelim_ortho_matrix,
+      prev_problem.weights,
+      100,
+      ZERO_ABS_THRESH);
+
+  ASSERT_TRUE(prev_result.has_converged);
+
+  // Problem whose orthonormal matrix is that of the previous problem
+  // perturbed and orthonormalized, so that the previous transform is not in
+  // its span.
+  auto problem = prev_problem;
+
+  {
+    Mat<real_t> perturbation(24, 8, arma::fill::randu);
+
+    MPI_Bcast(
+        perturbation.memptr(), perturbation.n_elem, MPI_DOUBLE, 0,
+        MPI_COMM_WORLD);
+
+    Mat<real_t> r;
+    arma::qr_econ(
+        problem.prelim_ortho_matrix,
+        r,
+        Mat<real_t>(prev_problem.prelim_ortho_matrix + 0.1 * perturbation));
+  }
+
+  const auto warm_result = WeightOrthogonalized(
+      MPI_COMM_WORLD,
+      problem.nonortho_matrix,
+      problem.prelim_ortho_matrix,
+      problem.weights,
+      prev_result,
+      100,
+      ZERO_ABS_THRESH);
+
+  ASSERT_TRUE(warm_result.has_converged);
+
+  const bool is_ortho = arma::approx_equal(
+      warm_result.transform.t() * warm_result.transform,
+      Mat<real_t>(8, 8, arma::fill::eye),
+      "absdiff",
+      APPROX_EQUAL_ABS_TOL);
+
+  ASSERT_TRUE(is_ortho);
+}
+
+} // namespace linear
+} // namespace math
+} // namespace tanuki
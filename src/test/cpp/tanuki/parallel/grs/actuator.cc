@@ -0,0 +1,741 @@
+#include <tanuki.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <armadillo>
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <omp.h>
+
+#define APPROX_EQUAL_ABS_TOL 1.0e-6
+#define CONVERGENCE_TOL 1.0e-10
+#define ZERO_ABS_TOL 1.0e-14
+
+namespace tanuki {
+namespace parallel {
+namespace grs {
+
+using std::vector;
+
+using arma::Col;
+using arma::Mat;
+
+using math::linear::CreateIdentityRotation;
+using math::linear::IndexedVectorPair;
+using math::linear::MatrixIndexPair;
+using math::linear::RotationMatrixSpec;
+using parallel::mpi::MpiBasicDatatype;
+
+using tanuki::number::complex_t;
+using tanuki::number::real_t;
+
+/**
+ *  @brief Rotation of one-sided Jacobi (Hestenes) that orthogonalizes two
+ *  vectors.
+ *
+ *  For complex vectors, the real part of the inner product is annihilated,
+ *  which is the same as for the real vectors of the real parts stacked on the
+ *  imaginary parts.
+ */
+template <typename T>
+RotationMatrixSpec TEST_Actuator_Rotate(const Col<T> &x, const Col<T> &y) {
+  const real_t alpha = std::real(arma::cdot(x, x));
+  const real_t beta = std::real(arma::cdot(y, y));
+  const real_t gamma = std::real(arma::cdot(x, y));
+
+  if (std::abs(gamma) <= ZERO_ABS_TOL * std::sqrt(alpha * beta)) {
+    return CreateIdentityRotation();
+  }
+
+  const real_t zeta = (beta - alpha) / (2.0 * gamma);
+
+  const real_t t = (zeta < 0.0 ? -1.0 : 1.0) /
+      (std::abs(zeta) + std::sqrt(1.0 + zeta * zeta));
+
+  const real_t c = 1.0 / std::sqrt(1.0 + t * t);
+
+  return {
+    .cosine = c,
+    .sine = c * t
+  };
+}
+
+/**
+ *  @brief Batched inquiry function of one-sided Jacobi.
+ */
+template <typename T>
+void TEST_Actuator_RotateBatch(
+    MatrixIndexPair::PairType pair_type,
+    const Mat<arma::uword> &index_pairs,
+    const Mat<T> &matrix,
+    std::vector<RotationMatrixSpec> &rotation_specs) {
+  for (size_t p = 0; p != index_pairs.n_cols; ++p) {
+    const auto i = index_pairs(0, p);
+    const auto j = index_pairs(1, p);
+
+    if (pair_type == MatrixIndexPair::PairType::COLUMNS) {
+      rotation_specs[p] = TEST_Actuator_Rotate<T>(
+          matrix.col(i), matrix.col(j));
+    } else {
+      rotation_specs[p] = TEST_Actuator_Rotate<T>(
+          matrix.row(i).st(), matrix.row(j).st());
+    }
+  }
+}
+
+/**
+ *  @brief Random matrix that is the same across MPI processes.
+ */
+template <typename T>
+Mat<T> TEST_Actuator_RandomMatrix(size_t num_rows, size_t num_cols) {
+  Mat<T> retval(num_rows, num_cols, arma::fill::randu);
+
+  MPI_Bcast(
+      retval.memptr(), retval.n_elem, MpiBasicDatatype<T>(), 0,
+      MPI_COMM_WORLD);
+
+  return retval;
+}
+
+/**
+ *  @brief Actuates one-sided Jacobi, by default from the right without
+ *  relaxation, until the sines do not exceed @link CONVERGENCE_TOL @endlink.
+ */
+template <typename T>
+Result<T> TEST_Actuator_Actuate(
+    const Mat<T> &input,
+    size_t num_groups,
+    const ActuatorOptions &options,
+    size_t max_iterations = 100,
+    JacobiSidedness sidedness = JacobiSidedness::ONE_SIDED_RIGHT,
+    real_t init_relax = 0.0) {
+  ActuatorOptions rotations_options = options;
+  rotations_options.convergence_criterion = ConvergenceCriterion::ROTATIONS;
+  rotations_options.convergence_tol = CONVERGENCE_TOL;
+
+  Actuator<T> actuator(
+      MPI_COMM_WORLD,
+      omp_get_max_threads(),
+      sidedness,
+      init_relax,
+      num_groups,
+      max_iterations,
+      [](size_t, real_t, size_t) -> real_t { return 0.0; },
+      [](const Mat<T> &, const Mat<T> &) -> bool { return false; },
+      rotations_options);
+
+  return actuator.Actuate(
+      input,
+      typename Actuator<T>::BatchInquiryFn(TEST_Actuator_RotateBatch<T>));
+}
+
+/**
+ *  @brief Tests that the columns of a converged transform are orthogonal.
+ */
+template <typename T>
+void TEST_Actuator_Orthogonal(const Result<T> &result) {
+  ASSERT_TRUE(result.has_converged);
+
+  const Mat<T> gram = result.transform.t() * result.transform;
+  const Mat<T> off_diagonal = gram - arma::diagmat(gram);
+
+  ASSERT_LT(arma::abs(off_diagonal).max(),
+            APPROX_EQUAL_ABS_TOL * arma::abs(gram).max());
+}
+
+/**
+ *  @brief Tests that two results are the same.
+ */
+template <typename T>
+void TEST_Actuator_SameResult(const Result<T> &a, const Result<T> &b) {
+  ASSERT_EQ(a.num_iters, b.num_iters);
+  ASSERT_EQ(a.has_converged, b.has_converged);
+
+  const bool is_transform_equal = arma::approx_equal(
+      a.transform, b.transform, "absdiff", APPROX_EQUAL_ABS_TOL);
+
+  ASSERT_TRUE(is_transform_equal);
+}
+
+/**
+ *  @brief Tests that the norms of the columns of a converged transform are
+ *  the singular values of the input matrix, which holds for any order of the
+ *  rotations.
+ */
+template <typename T>
+void TEST_Actuator_SingularValues(
+    const Mat<T> &input, const Result<T> &result) {
+  ASSERT_TRUE(result.has_converged);
+
+  const Col<real_t> col_norms = arma::sort(
+      Col<real_t>(
+          arma::sqrt(arma::sum(arma::square(arma::abs(result.transform)))).t()),
+      "descend");
+
+  const Col<real_t> singular_values = arma::svd(input);
+
+  const bool is_norms_equal = arma::approx_equal(
+      col_norms, singular_values, "absdiff", APPROX_EQUAL_ABS_TOL);
+
+  ASSERT_TRUE(is_norms_equal);
+}
+
+/**
+ *  @brief Tests that applying each group of rotation sets as a wavefront over
+ *  blocks of rows gives the same result as applying the rotation sets one at
+ *  a time.
+ */
+TEST(Actuator, Wavefront) {
+  const auto input = TEST_Actuator_RandomMatrix<real_t>(32, 16);
+
+  ActuatorOptions wavefront_options;
+  wavefront_options.is_wavefront = true;
+
+  for (const size_t num_groups : {1, 4}) {
+    const auto plain_result =
+        TEST_Actuator_Actuate(input, num_groups, ActuatorOptions());
+
+    // Blocks of rows that do not divide the number of rows, and a single
+    // block.
+    for (const size_t block_rows : {5, 256}) {
+      wavefront_options.wavefront_block_rows = block_rows;
+
+      const auto wavefront_result =
+          TEST_Actuator_Actuate(input, num_groups, wavefront_options);
+
+      TEST_Actuator_Orthogonal(wavefront_result);
+      TEST_Actuator_SameResult(plain_result, wavefront_result);
+    }
+  }
+}
+
+/**
+ *  @brief Tests that one-sided Jacobi from the left, which rotates the rows in
+ *  place, gives the transpose of the result from the right on the transposed
+ *  matrix.
+ */
+TEST(Actuator, OneSidedLeft) {
+  const auto input = TEST_Actuator_RandomMatrix<real_t>(32, 16);
+
+  for (const size_t num_groups : {1, 4}) {
+    const auto right_result =
+        TEST_Actuator_Actuate(input, num_groups, ActuatorOptions());
+
+    const auto left_result = TEST_Actuator_Actuate<real_t>(
+        input.t(),
+        num_groups,
+        ActuatorOptions(),
+        100,
+        JacobiSidedness::ONE_SIDED_LEFT);
+
+    ASSERT_EQ(left_result.num_iters, right_result.num_iters);
+    ASSERT_TRUE(left_result.has_converged);
+
+    const bool is_transform_equal = arma::approx_equal(
+        left_result.transform,
+        Mat<real_t>(right_result.transform.t()),
+        "absdiff",
+        APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_transform_equal);
+  }
+}
+
+/**
+ *  @brief Tests that accumulating the rotations of each block pair into a
+ *  matrix product orthogonalizes the columns.
+ *
+ *  Block rounds order the pairs differently from the round-robin tournament
+ *  of the columns, so the transform is compared by the singular values.
+ */
+TEST(Actuator, BlockRotations) {
+  const auto input = TEST_Actuator_RandomMatrix<real_t>(32, 16);
+
+  ActuatorOptions block_options;
+
+  for (const size_t num_groups : {1, 2}) {
+    // Blocks that divide the number of columns and that do not.
+    for (const size_t block_size : {4, 5}) {
+      block_options.block_size = block_size;
+
+      const auto block_result =
+          TEST_Actuator_Actuate(input, num_groups, block_options);
+
+      TEST_Actuator_Orthogonal(block_result);
+      TEST_Actuator_SingularValues(input, block_result);
+    }
+  }
+}
+
+/**
+ *  @brief Tests that the greedy ordering of the pairs by the angles of their
+ *  last rotations orthogonalizes the columns.
+ *
+ *  Greedy ordering differs from the round-robin tournament of the columns, so
+ *  the transform is compared by the singular values.
+ */
+TEST(Actuator, GreedyOrdering) {
+  const auto input = TEST_Actuator_RandomMatrix<real_t>(32, 16);
+
+  ActuatorOptions greedy_options;
+  greedy_options.ordering = std::make_shared<GreedyOrdering>();
+
+  for (const size_t num_groups : {1, 4}) {
+    const auto greedy_result =
+        TEST_Actuator_Actuate(input, num_groups, greedy_options);
+
+    TEST_Actuator_Orthogonal(greedy_result);
+    TEST_Actuator_SingularValues(input, greedy_result);
+  }
+}
+
+/**
+ *  @brief Tests that the batched inquiry function gives the same result as
+ *  the inquiry function of each pair.
+ */
+TEST(Actuator, BatchInquiry) {
+  const auto input = TEST_Actuator_RandomMatrix<real_t>(32, 16);
+
+  ActuatorOptions options;
+  options.convergence_criterion = ConvergenceCriterion::ROTATIONS;
+  options.convergence_tol = CONVERGENCE_TOL;
+
+  Actuator<real_t> actuator(
+      MPI_COMM_WORLD,
+      omp_get_max_threads(),
+      JacobiSidedness::ONE_SIDED_RIGHT,
+      0.0,
+      4,
+      100,
+      [](size_t, real_t, size_t) -> real_t { return 0.0; },
+      [](const Mat<real_t> &, const Mat<real_t> &) -> bool { return false; },
+      options);
+
+  const auto pair_result = actuator.Actuate(
+      input,
+      Actuator<real_t>::InquiryFn(
+          [](const IndexedVectorPair<real_t> &vector_pair)
+              -> RotationMatrixSpec {
+            return TEST_Actuator_Rotate<real_t>(
+                vector_pair.first, vector_pair.second);
+          }));
+
+  const auto batch_result = actuator.Actuate(
+      input,
+      Actuator<real_t>::BatchInquiryFn(TEST_Actuator_RotateBatch<real_t>));
+
+  TEST_Actuator_Orthogonal(batch_result);
+  TEST_Actuator_SameResult(pair_result, batch_result);
+}
+
+/**
+ *  @brief Tests that the rotation pairs claimed dynamically from the shared
+ *  counter over several groups give the same result as the static
+ *  delimitation, including when there are more groups than rotation sets so
+ *  that some groups are empty.
+ */
+TEST(Actuator, DynamicInquiry) {
+  const auto input = TEST_Actuator_RandomMatrix<real_t>(32, 16);
+
+  ActuatorOptions dynamic_options;
+  dynamic_options.is_dynamic_inquiry = true;
+
+  // Last number of groups exceeds the 15 rotation sets of 16 columns.
+  for (const size_t num_groups : {1, 3, 8, 20}) {
+    const auto static_result =
+        TEST_Actuator_Actuate(input, num_groups, ActuatorOptions());
+
+    // Chunks of one pair, and chunks that do not divide the number of pairs
+    // in a group.
+    for (const size_t chunk_size : {1, 3}) {
+      dynamic_options.inquiry_chunk_size = chunk_size;
+
+      const auto dynamic_result =
+          TEST_Actuator_Actuate(input, num_groups, dynamic_options);
+
+      TEST_Actuator_Orthogonal(dynamic_result);
+      TEST_Actuator_SameResult(static_result, dynamic_result);
+    }
+  }
+}
+
+/**
+ *  @brief Tests that the convergence by the rotation statistics and by the
+ *  distributed Frobenius norm of the change agree with the convergence by the
+ *  matrices.
+ */
+TEST(Actuator, ConvergenceCriteria) {
+  const auto input = TEST_Actuator_RandomMatrix<real_t>(32, 16);
+
+  const auto rotations_result = TEST_Actuator_Actuate(
+      input, 4, ActuatorOptions());
+
+  TEST_Actuator_Orthogonal(rotations_result);
+
+  // Test the statistics of the rotations in the last iteration.
+  ASSERT_LE(rotations_result.max_abs_sine, CONVERGENCE_TOL);
+  ASSERT_LE(rotations_result.sum_sq_sines,
+            rotations_result.max_abs_sine * rotations_result.max_abs_sine *
+                input.n_cols * input.n_cols);
+
+  ActuatorOptions frobenius_options;
+  frobenius_options.convergence_criterion = ConvergenceCriterion::FROBENIUS;
+  frobenius_options.convergence_tol = CONVERGENCE_TOL;
+
+  // Convergence checker of the matrices, which is used only by the default
+  // criterion.
+  const auto matrices_checker =
+      [](const Mat<real_t> &prev, const Mat<real_t> &curr) -> bool {
+        return arma::norm(curr - prev, "fro") <=
+            CONVERGENCE_TOL * arma::norm(curr, "fro");
+      };
+
+  for (const auto &options : {frobenius_options, ActuatorOptions()}) {
+    Actuator<real_t> actuator(
+        MPI_COMM_WORLD,
+        omp_get_max_threads(),
+        JacobiSidedness::ONE_SIDED_RIGHT,
+        0.0,
+        4,
+        100,
+        [](size_t, real_t, size_t) -> real_t { return 0.0; },
+        matrices_checker,
+        options);
+
+    const auto result = actuator.Actuate(
+        input,
+        Actuator<real_t>::BatchInquiryFn(TEST_Actuator_RotateBatch<real_t>));
+
+    TEST_Actuator_Orthogonal(result);
+
+    const bool is_transform_equal = arma::approx_equal(
+        rotations_result.transform,
+        result.transform,
+        "absdiff",
+        APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_transform_equal);
+  }
+}
+
+/**
+ *  @brief Tests that skipping the rotations whose angles are below a
+ *  threshold, with and without the decay of the threshold, converges to the
+ *  result without skipping.
+ */
+TEST(Actuator, SkipThreshold) {
+  const auto input = TEST_Actuator_RandomMatrix<real_t>(32, 16);
+
+  const auto plain_result = TEST_Actuator_Actuate(input, 4, ActuatorOptions());
+
+  for (const real_t decay : {0.1, 1.0}) {
+    ActuatorOptions threshold_options;
+    threshold_options.skip_threshold = CONVERGENCE_TOL;
+    threshold_options.skip_threshold_decay = decay;
+
+    const auto threshold_result =
+        TEST_Actuator_Actuate(input, 4, threshold_options);
+
+    TEST_Actuator_Orthogonal(threshold_result);
+
+    const bool is_transform_equal = arma::approx_equal(
+        plain_result.transform,
+        threshold_result.transform,
+        "absdiff",
+        APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_transform_equal);
+  }
+
+  // Test that a threshold above the convergence tolerance of the rotations
+  // is rejected.
+  {
+    ActuatorOptions invalid_options;
+    invalid_options.convergence_criterion = ConvergenceCriterion::ROTATIONS;
+    invalid_options.convergence_tol = CONVERGENCE_TOL;
+    invalid_options.skip_threshold = CONVERGENCE_TOL * 10.0;
+
+    ASSERT_THROW(
+        Actuator<real_t>(
+            MPI_COMM_WORLD,
+            1,
+            JacobiSidedness::ONE_SIDED_RIGHT,
+            0.0,
+            1,
+            1,
+            [](size_t, real_t, size_t) -> real_t { return 0.0; },
+            [](const Mat<real_t> &, const Mat<real_t> &) -> bool {
+              return false;
+            },
+            invalid_options),
+        std::domain_error);
+  }
+}
+
+/**
+ *  @brief Tests that the accumulated rotation transforms the input matrix to
+ *  the transform from either side.
+ */
+TEST(Actuator, AccumulatedRotation) {
+  const auto input = TEST_Actuator_RandomMatrix<real_t>(32, 16);
+
+  ActuatorOptions accumulated_options;
+  accumulated_options.is_rotation_accumulated = true;
+
+  // Rotation is not accumulated by default.
+  ASSERT_TRUE(
+      TEST_Actuator_Actuate(input, 4, ActuatorOptions()).rotation.is_empty());
+
+  {
+    const auto right_result =
+        TEST_Actuator_Actuate(input, 4, accumulated_options);
+
+    ASSERT_EQ(right_result.rotation.n_rows, input.n_cols);
+    ASSERT_EQ(right_result.rotation.n_cols, input.n_cols);
+
+    const bool is_transform_equal = arma::approx_equal(
+        Mat<real_t>(input * right_result.rotation),
+        right_result.transform,
+        "absdiff",
+        APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_transform_equal);
+  }
+
+  {
+    const auto left_result = TEST_Actuator_Actuate<real_t>(
+        input.t(),
+        4,
+        accumulated_options,
+        100,
+        JacobiSidedness::ONE_SIDED_LEFT);
+
+    ASSERT_EQ(left_result.rotation.n_rows, input.n_cols);
+    ASSERT_EQ(left_result.rotation.n_cols, input.n_cols);
+
+    const bool is_transform_equal = arma::approx_equal(
+        Mat<real_t>(left_result.rotation.t() * input.t()),
+        left_result.transform,
+        "absdiff",
+        APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_transform_equal);
+  }
+}
+
+/**
+ *  @brief Tests that the adaptive relaxation policy from a relaxed start
+ *  converges to orthogonal columns.
+ *
+ *  Relaxation changes the rotations along the way, so the transform is
+ *  compared by the singular values.
+ */
+TEST(Actuator, AdaptiveRelaxation) {
+  const auto input = TEST_Actuator_RandomMatrix<real_t>(32, 16);
+
+  ActuatorOptions adaptive_options;
+  adaptive_options.relaxation_policy = std::make_shared<AdaptiveRelaxation>();
+
+  for (const size_t num_groups : {1, 4}) {
+    const auto adaptive_result = TEST_Actuator_Actuate(
+        input,
+        num_groups,
+        adaptive_options,
+        100,
+        JacobiSidedness::ONE_SIDED_RIGHT,
+        GrsOneSidedRelaxParam(input.n_cols));
+
+    TEST_Actuator_Orthogonal(adaptive_result);
+    TEST_Actuator_SingularValues(input, adaptive_result);
+  }
+}
+
+/**
+ *  @brief Tests that the actuation of a complex matrix is the same as that of
+ *  the real matrix of its real parts stacked on its imaginary parts.
+ *
+ *  Rotations are real, so they rotate the real and imaginary parts as
+ *  separate real streams.
+ */
+TEST(Actuator, Complex) {
+  const auto input = TEST_Actuator_RandomMatrix<complex_t>(16, 16);
+
+  const Mat<real_t> stacked_input =
+      arma::join_vert(arma::real(input), arma::imag(input));
+
+  for (const size_t num_groups : {1, 4}) {
+    const auto complex_result =
+        TEST_Actuator_Actuate(input, num_groups, ActuatorOptions());
+
+    const auto stacked_result =
+        TEST_Actuator_Actuate(stacked_input, num_groups, ActuatorOptions());
+
+    ASSERT_TRUE(complex_result.has_converged);
+    ASSERT_EQ(complex_result.num_iters, stacked_result.num_iters);
+
+    const bool is_transform_equal = arma::approx_equal(
+        Mat<real_t>(
+            arma::join_vert(
+                arma::real(complex_result.transform),
+                arma::imag(complex_result.transform))),
+        stacked_result.transform,
+        "absdiff",
+        APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_transform_equal);
+  }
+}
+
+/**
+ *  @brief Tests that the mixed-precision actuation reaches the convergence
+ *  tolerance in double precision.
+ */
+TEST(Actuator, MixedPrecision) {
+  const auto input = TEST_Actuator_RandomMatrix<real_t>(32, 16);
+
+  ActuatorOptions options;
+  options.convergence_criterion = ConvergenceCriterion::ROTATIONS;
+  options.convergence_tol = CONVERGENCE_TOL;
+
+  Actuator<real_t> actuator(
+      MPI_COMM_WORLD,
+      omp_get_max_threads(),
+      JacobiSidedness::ONE_SIDED_RIGHT,
+      0.0,
+      4,
+      100,
+      [](size_t, real_t, size_t) -> real_t { return 0.0; },
+      [](const Mat<real_t> &, const Mat<real_t> &) -> bool { return false; },
+      options);
+
+  const auto result = actuator.Actuate(
+      input,
+      Actuator<real_t>::BatchInquiryFn(TEST_Actuator_RotateBatch<real_t>),
+      Actuator<float>::BatchInquiryFn(TEST_Actuator_RotateBatch<float>));
+
+  ASSERT_LE(result.max_abs_sine, CONVERGENCE_TOL);
+
+  TEST_Actuator_Orthogonal(result);
+  TEST_Actuator_SingularValues(input, result);
+}
+
+/**
+ *  @brief Tests that actuating several problems together gives the same
+ *  results as actuating each problem separately.
+ *
+ *  Each group is a single rotation set, so the rotations of each problem do
+ *  not depend on the grouping of the interleaved rotation sets.
+ */
+TEST(Actuator, MultiProblem) {
+  const vector<Mat<real_t>> inputs = {
+    TEST_Actuator_RandomMatrix<real_t>(32, 8),
+    TEST_Actuator_RandomMatrix<real_t>(32, 8)
+  };
+
+  // Number of rotation sets in an iteration of each problem.
+  const size_t num_groups = inputs.front().n_cols - 1;
+
+  ActuatorOptions options;
+  options.convergence_criterion = ConvergenceCriterion::ROTATIONS;
+  options.convergence_tol = CONVERGENCE_TOL;
+
+  Actuator<real_t> actuator(
+      MPI_COMM_WORLD,
+      omp_get_max_threads(),
+      JacobiSidedness::ONE_SIDED_RIGHT,
+      0.0,
+      num_groups,
+      100,
+      [](size_t, real_t, size_t) -> real_t { return 0.0; },
+      [](const Mat<real_t> &, const Mat<real_t> &) -> bool { return false; },
+      options);
+
+  const auto results = actuator.Actuate(
+      inputs,
+      vector<Actuator<real_t>::BatchInquiryFn>(
+          inputs.size(), TEST_Actuator_RotateBatch<real_t>));
+
+  ASSERT_EQ(results.size(), inputs.size());
+
+  for (size_t p = 0; p != inputs.size(); ++p) {
+    const auto separate_result =
+        TEST_Actuator_Actuate(inputs[p], num_groups, ActuatorOptions());
+
+    ASSERT_TRUE(results[p].has_converged);
+
+    // Problems converge together, so a problem may be iterated after it has
+    // converged.
+    ASSERT_GE(results[p].num_iters, separate_result.num_iters);
+
+    const bool is_transform_equal = arma::approx_equal(
+        results[p].transform,
+        separate_result.transform,
+        "absdiff",
+        APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_transform_equal);
+  }
+}
+
+/**
+ *  @brief Tests that an actuation resumed from a checkpoint gives the same
+ *  result as an uninterrupted actuation.
+ */
+TEST(Actuator, Checkpoint) {
+  const auto input = TEST_Actuator_RandomMatrix<real_t>(32, 16);
+
+  const auto uninterrupted_result =
+      TEST_Actuator_Actuate(input, 4, ActuatorOptions());
+
+  ActuatorOptions checkpoint_options;
+  checkpoint_options.checkpoint_path = "test_actuator_checkpoint";
+
+  // Actuation that is stopped after the checkpoint of the second iteration.
+  {
+    const auto interrupted_result =
+        TEST_Actuator_Actuate(input, 4, checkpoint_options, 3);
+
+    ASSERT_FALSE(interrupted_result.has_converged);
+  }
+
+  checkpoint_options.is_checkpoint_resumed = true;
+
+  // Input matrix is replaced by the checkpointed matrix, so a zero matrix
+  // gives the same result only if the actuation has resumed.
+  const auto resumed_result = TEST_Actuator_Actuate(
+      Mat<real_t>(arma::size(input), arma::fill::zeros),
+      4,
+      checkpoint_options);
+
+  TEST_Actuator_SameResult(uninterrupted_result, resumed_result);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // Checkpoint file of each host is written by the MPI process of rank zero
+  // at the host.
+  {
+    const parallel::mpi::MpiHostBasedComms host_based_comms(MPI_COMM_WORLD);
+
+    int intrahost_rank;
+    MPI_Comm_rank(host_based_comms.intrahost(), &intrahost_rank);
+
+    int interhost_rank;
+    MPI_Comm_rank(host_based_comms.interhost(), &interhost_rank);
+
+    if (intrahost_rank == 0) {
+      std::remove(
+          (checkpoint_options.checkpoint_path + "." +
+               std::to_string(interhost_rank)).c_str());
+    }
+  }
+}
+
+} // namespace grs
+} // namespace parallel
+} // namespace tanuki
@@ -0,0 +1,101 @@
+#include <tanuki.h>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#define APPROX_EQUAL_ABS_TOL 1.0e-12
+
+namespace tanuki {
+namespace parallel {
+namespace grs {
+
+/**
+ *  @brief Tests that two tuned parameters are the same.
+ */
+void TEST_Autotuner_SameParams(const TuningParams &a, const TuningParams &b) {
+  ASSERT_EQ(a.num_groups, b.num_groups);
+  ASSERT_EQ(a.max_threads, b.max_threads);
+  ASSERT_NEAR(a.init_relax, b.init_relax, APPROX_EQUAL_ABS_TOL);
+}
+
+/**
+ *  @brief Tests that the tunings stored in a tuning file are loaded from it.
+ */
+TEST(TuningFile, RoundTrip) {
+  int mpi_rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+
+  // Tuning file of each MPI process.
+  const std::string path =
+      "test_autotuner_tuning." + std::to_string(mpi_rank);
+
+  std::remove(path.c_str());
+
+  const TuningKey key = {
+    .num_rows = 40,
+    .num_cols = 8,
+    .num_procs = 4,
+    .num_hosts = 2
+  };
+
+  const TuningKey other_key = {
+    .num_rows = 40,
+    .num_cols = 8,
+    .num_procs = 4,
+    .num_hosts = 1
+  };
+
+  const TuningParams params = {
+    .num_groups = 8,
+    .max_threads = 2,
+    .init_relax = 0.123456789
+  };
+
+  const TuningParams other_params = {
+    .num_groups = 4,
+    .max_threads = 1,
+    .init_relax = 0.0
+  };
+
+  // Test that a new file has no tunings.
+  {
+    TuningFile tuning_file(path);
+
+    ASSERT_FALSE(tuning_file.Contains(key));
+    ASSERT_THROW(tuning_file.At(key), std::out_of_range);
+
+    tuning_file.Store(key, other_params);
+    tuning_file.Store(other_key, other_params);
+
+    // Stored parameters replace the existing ones.
+    tuning_file.Store(key, params);
+  }
+
+  {
+    const TuningFile tuning_file(path);
+
+    ASSERT_TRUE(tuning_file.Contains(key));
+    ASSERT_TRUE(tuning_file.Contains(other_key));
+
+    TEST_Autotuner_SameParams(tuning_file.At(key), params);
+    TEST_Autotuner_SameParams(tuning_file.At(other_key), other_params);
+  }
+
+  // Test that a file that cannot be parsed is rejected.
+  {
+    std::ofstream(path) << "not a tuning\n";
+
+    ASSERT_THROW(TuningFile tuning_file(path), std::runtime_error);
+  }
+
+  std::remove(path.c_str());
+}
+
+} // namespace grs
+} // namespace parallel
+} // namespace tanuki
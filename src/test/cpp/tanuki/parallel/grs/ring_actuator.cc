@@ -0,0 +1,133 @@
+#include <tanuki.h>
+
+#include <cmath>
+#include <cstddef>
+
+#include <armadillo>
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <omp.h>
+
+#define APPROX_EQUAL_ABS_TOL 1.0e-6
+#define CONVERGENCE_ABS_TOL 1.0e-12
+#define ZERO_ABS_TOL 1.0e-14
+
+namespace tanuki {
+namespace parallel {
+namespace grs {
+
+using arma::Col;
+using arma::Mat;
+
+using math::linear::CreateIdentityRotation;
+using math::linear::IndexedVectorPair;
+using math::linear::RotationMatrixSpec;
+
+using tanuki::number::real_t;
+
+/**
+ *  @brief Inquiry function of one-sided Jacobi (Hestenes) that orthogonalizes
+ *  two columns.
+ */
+RotationMatrixSpec TEST_RingActuator_Rotate(
+    const IndexedVectorPair<real_t> &vector_pair) {
+  const real_t alpha = arma::dot(vector_pair.first, vector_pair.first);
+  const real_t beta = arma::dot(vector_pair.second, vector_pair.second);
+  const real_t gamma = arma::dot(vector_pair.first, vector_pair.second);
+
+  if (std::abs(gamma) <= ZERO_ABS_TOL * std::sqrt(alpha * beta)) {
+    return CreateIdentityRotation();
+  }
+
+  const real_t zeta = (beta - alpha) / (2.0 * gamma);
+
+  const real_t t = (zeta < 0.0 ? -1.0 : 1.0) /
+      (std::abs(zeta) + std::sqrt(1.0 + zeta * zeta));
+
+  const real_t c = 1.0 / std::sqrt(1.0 + t * t);
+
+  return {
+    .cosine = c,
+    .sine = c * t
+  };
+}
+
+/**
+ *  @brief Tests that the columns distributed across the MPI processes and
+ *  exchanged in a ring are orthogonalized as the whole matrix is by @link
+ *  Actuator @endlink.
+ *
+ *  Ring orders the pairs differently from the round-robin tournament of the
+ *  columns, so the gathered transform is compared by the singular values.
+ */
+TEST(RingActuator, Orthogonalize) {
+  int mpi_rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+
+  int mpi_comm_size;
+  MPI_Comm_size(MPI_COMM_WORLD, &mpi_comm_size);
+
+  // Number of columns owned by each MPI process.
+  const size_t num_local_cols = 4;
+
+  Mat<real_t> input(24, num_local_cols * mpi_comm_size, arma::fill::randu);
+
+  MPI_Bcast(input.memptr(), input.n_elem, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+  RingActuator<real_t> actuator(
+      MPI_COMM_WORLD,
+      omp_get_max_threads(),
+      0.0,
+      100,
+      [](size_t, real_t, size_t) -> real_t { return 0.0; },
+      [](const Mat<real_t> &prev, const Mat<real_t> &curr) -> bool {
+        return arma::approx_equal(
+            prev, curr, "absdiff", CONVERGENCE_ABS_TOL);
+      });
+
+  const auto result = actuator.Actuate(
+      Mat<real_t>(
+          input.cols(
+              mpi_rank * num_local_cols,
+              (mpi_rank + 1) * num_local_cols - 1)),
+      TEST_RingActuator_Rotate);
+
+  ASSERT_TRUE(result.has_converged);
+  ASSERT_EQ(result.transform.n_rows, input.n_rows);
+  ASSERT_EQ(result.transform.n_cols, num_local_cols);
+
+  // Transform of the whole matrix.
+  Mat<real_t> transform(arma::size(input));
+
+  MPI_Allgather(
+      result.transform.memptr(), result.transform.n_elem, MPI_DOUBLE,
+      transform.memptr(), result.transform.n_elem, MPI_DOUBLE,
+      MPI_COMM_WORLD);
+
+  // Test that the columns are orthogonal.
+  {
+    const Mat<real_t> gram = transform.t() * transform;
+    const Mat<real_t> off_diagonal = gram - arma::diagmat(gram);
+
+    ASSERT_LT(arma::abs(off_diagonal).max(),
+              APPROX_EQUAL_ABS_TOL * arma::abs(gram).max());
+  }
+
+  // Test that the norms of the columns are the singular values.
+  {
+    const Col<real_t> col_norms = arma::sort(
+        Col<real_t>(arma::sqrt(arma::sum(arma::square(transform))).t()),
+        "descend");
+
+    const Col<real_t> singular_values = arma::svd(input);
+
+    const bool is_norms_equal = arma::approx_equal(
+        col_norms, singular_values, "absdiff", APPROX_EQUAL_ABS_TOL);
+
+    ASSERT_TRUE(is_norms_equal);
+  }
+}
+
+} // namespace grs
+} // namespace parallel
+} // namespace tanuki
@@ -0,0 +1,66 @@
+#include <tanuki.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+namespace tanuki {
+namespace parallel {
+namespace mpi {
+
+using std::vector;
+
+/**
+ *  @brief Tests that repeated gatherings of a different number of elements
+ *  from each MPI process, blocking and started without waiting, give the
+ *  elements of all MPI processes.
+ */
+TEST(MpiPersistentAllgatherv, Repeated) {
+  int mpi_rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+
+  int mpi_comm_size;
+  MPI_Comm_size(MPI_COMM_WORLD, &mpi_comm_size);
+
+  // MPI process of rank r contributes r + 1 elements after a gap of one
+  // element.
+  vector<int> recv_counts(mpi_comm_size);
+  vector<int> displs(mpi_comm_size);
+
+  for (int rank = 0; rank != mpi_comm_size; ++rank) {
+    recv_counts[rank] = rank + 1;
+    displs[rank] = rank == 0 ? 1 : displs[rank - 1] + recv_counts[rank - 1] + 1;
+  }
+
+  vector<long long> buf(displs.back() + recv_counts.back(), -1);
+
+  MpiPersistentAllgatherv gather(
+      MPI_COMM_WORLD, buf.data(), recv_counts, displs, MPI_LONG_LONG);
+
+  for (int run = 0; run != 3; ++run) {
+    for (int k = 0; k != recv_counts[mpi_rank]; ++k) {
+      buf[displs[mpi_rank] + k] = run * 1000 + mpi_rank * 10 + k;
+    }
+
+    if (run % 2 == 0) {
+      gather.Run();
+    } else {
+      gather.Start();
+      gather.Wait();
+    }
+
+    for (int rank = 0; rank != mpi_comm_size; ++rank) {
+      // Gap before the elements is not touched.
+      ASSERT_EQ(buf[displs[rank] - 1], -1);
+
+      for (int k = 0; k != recv_counts[rank]; ++k) {
+        ASSERT_EQ(buf[displs[rank] + k], run * 1000 + rank * 10 + k);
+      }
+    }
+  }
+}
+
+} // namespace mpi
+} // namespace parallel
+} // namespace tanuki